@@ -0,0 +1,213 @@
+#include "AnalysisDaemon.h"
+#include "LocalSocket.h"
+
+#include <iostream>
+#include <sstream>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Ограничение одного блока строк в потоковом запросе
+static const size_t kMaxChunkSize = 256 * 1024 * 1024;
+
+AnalysisDaemon::AnalysisDaemon(const AnalysisOptions& options, int workers)
+    : options_(options),
+    worker_count_(workers > 0 ? workers : 1),
+    listen_fd_(-1),
+    stop_requested_(false),
+    stopping_(false)
+{
+}
+
+AnalysisDaemon::~AnalysisDaemon()
+{
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        ::unlink(socket_path_.c_str());
+    }
+}
+
+bool AnalysisDaemon::listen(const std::string& socket_path)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        error_ = "Socket path is too long: " + socket_path;
+        return false;
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        error_ = std::string("Failed to create socket: ") + std::strerror(errno);
+        return false;
+    }
+    // Сокет, оставшийся от прошлого запуска, занимает путь
+    ::unlink(socket_path.c_str());
+    if (::bind(listen_fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listen_fd_, SOMAXCONN) != 0) {
+        error_ = "Failed to listen on " + socket_path + ": " + std::strerror(errno);
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+    socket_path_ = socket_path;
+    return true;
+}
+
+int AnalysisDaemon::run()
+{
+    if (listen_fd_ < 0) {
+        std::cout << "Error: Daemon socket is not open" << std::endl;
+        return 1;
+    }
+    for (int i = 0; i < worker_count_; ++i) {
+        workers_.emplace_back(&AnalysisDaemon::workerLoop, this);
+    }
+    std::cout << "Daemon listening on " << socket_path_ << " with "
+              << worker_count_ << " workers" << std::endl;
+    pollfd listen_poll;
+    listen_poll.fd = listen_fd_;
+    listen_poll.events = POLLIN;
+    while (!stop_requested_.load()) {
+        // Короткий таймаут, чтобы заметить запрос остановки без сигнала в accept
+        int ready = ::poll(&listen_poll, 1, 200);
+        if (ready <= 0) {
+            continue;
+        }
+        int client_fd = ::accept(listen_fd_, nullptr, nullptr);
+        if (client_fd < 0) {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.push_back(client_fd);
+        }
+        pending_ready_.notify_one();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    pending_ready_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+    std::cout << "Daemon stopped (solve cache: " << cache_.size() << " formulas, "
+              << cache_.hits() << " hits, " << cache_.misses() << " misses)" << std::endl;
+    return 0;
+}
+
+void AnalysisDaemon::workerLoop()
+{
+    for (;;) {
+        int client_fd;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            pending_ready_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            // Принятые до остановки запросы дорабатываются
+            if (pending_.empty()) {
+                return;
+            }
+            client_fd = pending_.front();
+            pending_.pop_front();
+        }
+        LocalSocket socket(client_fd);
+        handleConnection(socket);
+    }
+}
+
+void AnalysisDaemon::handleConnection(LocalSocket& socket)
+{
+    std::string request;
+    if (!socket.readLine(request)) {
+        return;
+    }
+    std::istringstream fields(request);
+    std::string command;
+    std::string mode;
+    fields >> command >> mode;
+    std::string trace_path;
+    std::getline(fields >> std::ws, trace_path);
+    const bool valid = (mode == "log" || mode == "summary")
+                       && ((command == "ANALYZE" && !trace_path.empty()) || command == "STREAM");
+    if (!valid) {
+        socket.writeAll("RESULT error\n");
+        return;
+    }
+
+    // Каждый запрос получает свежий анализатор; общий только кэш вердиктов
+    std::ostringstream log;
+    Parser_JSON parser;
+    parser.setOutput(log);
+    parser.setSolveCache(&cache_);
+    bool success = options_.configure(parser);
+    if (success && command == "ANALYZE") {
+        success = parser.parseFile(trace_path);
+    } else if (success) {
+        success = readStream(socket, parser);
+    }
+    parser.printRunSummary(success);
+
+    std::string response;
+    if (mode == "log") {
+        const std::string text = log.str();
+        response += "LOG " + std::to_string(text.size()) + "\n" + text;
+    }
+    for (const TraceAnalyzer::TreeVerdict& verdict : parser.currentVerdicts()) {
+        const char* state = !verdict.up_to_date ? "stale"
+                            : verdict.has_leak ? "leak" : verdict.unknown ? "unknown" : "ok";
+        response += std::string("TREE ") + state + " " + verdict.tree + "\n";
+    }
+    const char* result = !success ? "error"
+                         : parser.hasMemoryLeak() ? "leak"
+                         : parser.unknownVerdictCount() > 0 || parser.timeLimitExceeded() ? "unknown" : "ok";
+    // Причина остановки нужна клиенту для тех же кодов выхода, что у однократного запуска
+    const char* stop = !success ? ""
+                       : parser.stoppedOnLeak() ? " fail-fast"
+                       : parser.timeLimitExceeded() ? " time-limit" : "";
+    response += std::string("RESULT ") + result + stop + "\n";
+    socket.writeAll(response);
+
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    std::cout << "Request " << command << " "
+              << (command == "ANALYZE" ? trace_path : std::string("<stream>"))
+              << ": " << result << stop << std::endl;
+}
+
+bool AnalysisDaemon::readStream(LocalSocket& socket, Parser_JSON& parser)
+{
+    if (!parser.beginSession()) {
+        return false;
+    }
+    std::string line;
+    std::string chunk;
+    bool ok = true;
+    while (socket.readLine(line)) {
+        if (line == "FINISH") {
+            // После ошибки анализа сеанс закрывается без финального анализа
+            return parser.finishSession() && ok;
+        }
+        if (line.compare(0, 5, "ROWS ") != 0) {
+            break;
+        }
+        char* end = nullptr;
+        unsigned long long size = std::strtoull(line.c_str() + 5, &end, 10);
+        if (*end != '\0' || size > kMaxChunkSize || !socket.readExact(static_cast<size_t>(size), chunk)) {
+            break;
+        }
+        // После ошибки или досрочной остановки блоки дочитываются без анализа,
+        // чтобы ответ пришел после FINISH
+        if (ok && !parser.isStopped()) {
+            ok = parser.pushJson(chunk) || parser.isStopped();
+        }
+    }
+    parser.output() << "Error: Incomplete row stream" << std::endl;
+    parser.abortSession();
+    return false;
+}
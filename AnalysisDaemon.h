@@ -0,0 +1,62 @@
+#ifndef ANALYSISDAEMON_H
+#define ANALYSISDAEMON_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+
+#include "AnalysisOptions.h"
+#include "SolveCache.h"
+
+class LocalSocket;
+
+// Долгоживущий режим: запросы принимаются через Unix-сокет и выполняются пулом
+// рабочих потоков; кэш вердиктов формул общий для всех запросов.
+//
+// Протокол (одно соединение — один запрос, строки завершаются '\n'):
+//   ANALYZE <log|summary> <путь к трассе>
+//   STREAM <log|summary>, затем блоки "ROWS <байт>\n<JSON>" и строка FINISH
+// Ответ:
+//   LOG <байт>\n<вывод анализа, как у однократного запуска>   (только в режиме log)
+//   TREE <leak|ok|unknown|stale> <имя дерева>                  (для каждого дерева)
+//   RESULT <ok|leak|unknown|error> [fail-fast|time-limit]       (причина досрочной остановки)
+class AnalysisDaemon
+{
+public:
+    AnalysisDaemon(const AnalysisOptions& options, int workers);
+    ~AnalysisDaemon();
+
+    bool listen(const std::string& socket_path);
+    // Цикл приема соединений до stop()
+    int run();
+    // Можно вызывать из обработчика сигнала
+    void stop() { stop_requested_.store(true); }
+
+    const std::string& errorString() const { return error_; }
+
+private:
+    AnalysisOptions options_;
+    int worker_count_;
+    int listen_fd_;
+    std::string socket_path_;
+    std::string error_;
+    std::atomic<bool> stop_requested_;
+
+    SolveCache cache_;
+    std::vector<std::thread> workers_;
+    std::deque<int> pending_;           // Принятые соединения, ожидающие рабочего потока
+    std::mutex mutex_;
+    std::condition_variable pending_ready_;
+    bool stopping_;
+    std::mutex log_mutex_;              // Вывод самого демона в stdout
+
+    void workerLoop();
+    void handleConnection(LocalSocket& socket);
+    bool readStream(LocalSocket& socket, Parser_JSON& parser);
+};
+
+#endif // ANALYSISDAEMON_H
@@ -0,0 +1,31 @@
+#include "AnalysisOptions.h"
+
+bool AnalysisOptions::configure(Parser_JSON& parser) const
+{
+    parser.setPositionCompaction(compact_positions);
+    parser.setSiteSummaryLimit(site_summary_limit);
+    parser.setPipelineEnabled(pipeline);
+    if (!solver_spec.empty() && !parser.setSolverBackend(solver_spec)) {
+        return false;
+    }
+    if (!portfolio_members.empty() && !parser.setPortfolio(portfolio_members, portfolio_threshold)) {
+        return false;
+    }
+    SolveBudget budget;
+    budget.conflicts = solve_conflicts;
+    budget.propagations = solve_propagations;
+    parser.setSolveBudget(budget);
+    parser.setSolveTimeout(solve_timeout_ms);
+    parser.setTraceTimeLimit(trace_time_limit);
+    parser.setMemoryBudget(static_cast<size_t>(memory_budget_mb) << 20, spill_file);
+    if (parser.getTreeManager()->hasError()) {
+        parser.output() << "Error: " << parser.getTreeManager()->errorString() << std::endl;
+        return false;
+    }
+    parser.setDimacsDumpDirectory(dimacs_dir);
+    parser.setShowModel(show_model);
+    parser.setReportMode(report_mode);
+    parser.setFailFast(fail_fast);
+    parser.output() << "Solver backend: " << parser.solverName() << std::endl;
+    return true;
+}
@@ -0,0 +1,31 @@
+#ifndef ANALYSISOPTIONS_H
+#define ANALYSISOPTIONS_H
+
+#include <string>
+#include "Parser_JSON.h"
+
+// Настройки анализа из командной строки; общие для однократного запуска и демона
+struct AnalysisOptions
+{
+    bool compact_positions = false;
+    bool pipeline = true;
+    bool show_model = false;
+    TraceAnalyzer::ReportMode report_mode = TraceAnalyzer::FullReport;
+    std::string solver_spec;
+    std::string dimacs_dir;
+    std::string portfolio_members;
+    int portfolio_threshold = 1000;
+    int site_summary_limit = 0;
+    bool fail_fast = false;
+    int solve_conflicts = 0;
+    int solve_propagations = 0;
+    int solve_timeout_ms = 0;
+    int trace_time_limit = 0;
+    int memory_budget_mb = 0;
+    std::string spill_file;
+
+    // Применить к анализатору; ошибка настройки решателя выводится в поток анализатора
+    bool configure(Parser_JSON& parser) const;
+};
+
+#endif // ANALYSISOPTIONS_H
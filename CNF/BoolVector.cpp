@@ -4,12 +4,15 @@
 #include <string.h>
 
 size_t BoolVector::calculateBytes(size_t bits) const {
-    return ((bits - 1) / 8) + 1;
+    return bits == 0 ? 0 : ((bits - 1) / 8) + 1;
 }
 
 BoolVector::BoolVector() : vector(nullptr), bits(0), bytes(0) {}
 
-BoolVector::BoolVector(size_t input_bits) {
+BoolVector::BoolVector(size_t input_bits) : vector(nullptr), bits(0), bytes(0) {
+    if (input_bits == 0) {
+        return;
+    }
     bits = input_bits;
     bytes = calculateBytes(bits);
     vector = (unsigned char*)malloc(bytes);
@@ -254,6 +257,13 @@ void BoolVector::clearBit(size_t position) {
     }
 }
 
+bool BoolVector::getBit(size_t position) const {
+    if (vector && position < bits) {
+        return (vector[position / 8] >> (7 - (position % 8))) & 1;
+    }
+    return false;
+}
+
 bool BoolVector::isZero() const {
     if (vector && bits > 0) {
         for (size_t i = 0; i < bytes; i++) {
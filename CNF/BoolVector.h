@@ -14,6 +14,7 @@ private:
 
 public:
     BoolVector();
+    BoolVector(size_t input_bits);
     BoolVector(const char* str);
     ~BoolVector();
     BoolVector(const BoolVector& other);
@@ -28,7 +29,9 @@ public:
     void shiftLeft(size_t shift);
     void setBit(size_t position);
     void clearBit(size_t position);
+    bool getBit(size_t position) const;
     bool isZero() const;
+    size_t size() const { return bits; }
 };
 
 #endif // BOOLVECTOR_H
\ No newline at end of file
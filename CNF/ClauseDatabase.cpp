@@ -0,0 +1,30 @@
+#include "ClauseDatabase.h"
+
+void ClauseDatabase::add(const int* literals, size_t count)
+{
+    literals_.insert(literals_.end(), literals, literals + count);
+    closeClause();
+}
+
+void ClauseDatabase::truncate(size_t count)
+{
+    if (count >= size()) {
+        // Незакрытая клауза отбрасывается
+        literals_.resize(offsets_.back());
+        return;
+    }
+    literals_.resize(offsets_[count]);
+    offsets_.resize(count + 1);
+}
+
+void ClauseDatabase::reserve(size_t clauses, size_t literals)
+{
+    offsets_.reserve(clauses + 1);
+    literals_.reserve(literals);
+}
+
+void ClauseDatabase::release()
+{
+    std::vector<int>().swap(literals_);
+    std::vector<uint32_t>(1, 0).swap(offsets_);
+}
@@ -0,0 +1,89 @@
+#ifndef CLAUSEDATABASE_H
+#define CLAUSEDATABASE_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Клаузы формулы в одном непрерывном буфере литералов: клауза i занимает
+// literals_[offsets_[i], offsets_[i + 1]). Добавление — амортизированно O(1)
+// без отдельного выделения памяти на клаузу, обход идет по буферу подряд,
+// удаление хвоста и очистка — одной операцией без освобождения памяти
+class ClauseDatabase
+{
+public:
+    // Представление клаузы: литералы в буфере базы. Действительно до следующего
+    // изменения базы
+    class Clause
+    {
+    public:
+        Clause(const int* begin, const int* end) : begin_(begin), end_(end) {}
+
+        const int* begin() const { return begin_; }
+        const int* end() const { return end_; }
+        size_t size() const { return static_cast<size_t>(end_ - begin_); }
+        bool empty() const { return begin_ == end_; }
+        int operator[](size_t index) const { return begin_[index]; }
+
+    private:
+        const int* begin_;
+        const int* end_;
+    };
+
+    class const_iterator
+    {
+    public:
+        const_iterator(const ClauseDatabase* database, size_t index) : database_(database), index_(index) {}
+
+        Clause operator*() const { return (*database_)[index_]; }
+        const_iterator& operator++() { ++index_; return *this; }
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+    private:
+        const ClauseDatabase* database_;
+        size_t index_;
+    };
+
+    ClauseDatabase() : offsets_(1, 0) {}
+
+    // Добавить клаузу целиком
+    void add(const int* literals, size_t count);
+    void add(const std::vector<int>& clause) { add(clause.data(), clause.size()); }
+    // Добавить клаузу по литералу: addLiteral(...)... closeClause()
+    void addLiteral(int literal) { literals_.push_back(literal); }
+    void closeClause() { offsets_.push_back(static_cast<uint32_t>(literals_.size())); }
+
+    size_t size() const { return offsets_.size() - 1; }
+    bool empty() const { return size() == 0; }
+    size_t literalCount() const { return offsets_.back(); }
+    Clause operator[](size_t index) const
+    {
+        const int* base = literals_.data();
+        return Clause(base + offsets_[index], base + offsets_[index + 1]);
+    }
+    // Литералы клаузы для перестановки на месте (наблюдаемые литералы решателя)
+    int* mutableLiterals(size_t index) { return literals_.data() + offsets_[index]; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+    // Литералы всех клауз подряд, без разделителей
+    const std::vector<int>& literals() const { return literals_; }
+
+    // Удалить клаузы начиная с count (и незакрытые литералы); память сохраняется
+    void truncate(size_t count);
+    void clear() { truncate(0); }
+    void reserve(size_t clauses, size_t literals);
+    // Освободить память буферов
+    void release();
+
+    bool operator==(const ClauseDatabase& other) const
+    {
+        return offsets_ == other.offsets_ && literals_ == other.literals_;
+    }
+
+private:
+    std::vector<int> literals_;
+    std::vector<uint32_t> offsets_;     // Начала клауз и конец последней (size() + 1)
+};
+
+#endif // CLAUSEDATABASE_H
@@ -0,0 +1,92 @@
+#include "CnfFormula.h"
+#include <sstream>
+#include <cstdlib>
+
+void CnfFormula::addClause(const int* literals, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        int variable = std::abs(literals[i]);
+        if (variable > num_vars) {
+            num_vars = variable;
+        }
+    }
+    clauses.add(literals, count);
+}
+
+void CnfFormula::clear()
+{
+    num_vars = 0;
+    clauses.clear();
+}
+
+bool readDimacs(std::istream& in, CnfFormula& formula, std::string& error)
+{
+    formula.clear();
+    bool has_header = false;
+    int declared_vars = 0;
+    long declared_clauses = 0;
+    std::vector<int> clause;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream tokens(line);
+        std::string first;
+        if (!(tokens >> first) || first[0] == 'c' || first[0] == '%') {
+            continue; // Пустая строка, комментарий или маркер конца (SATLIB)
+        }
+        if (first == "p") {
+            std::string format;
+            if (has_header || !(tokens >> format >> declared_vars >> declared_clauses) ||
+                format != "cnf" || declared_vars < 0 || declared_clauses < 0) {
+                error = "Invalid DIMACS header: " + line;
+                return false;
+            }
+            has_header = true;
+            continue;
+        }
+        if (!has_header) {
+            error = "Missing DIMACS header";
+            return false;
+        }
+        // Клауза может занимать несколько строк и заканчивается нулем
+        std::istringstream literals(line);
+        long literal = 0;
+        while (literals >> literal) {
+            if (literal == 0) {
+                formula.addClause(clause);
+                clause.clear();
+            } else if (std::labs(literal) > declared_vars) {
+                error = "Literal out of range: " + std::to_string(literal);
+                return false;
+            } else {
+                clause.push_back(static_cast<int>(literal));
+            }
+        }
+        if (!literals.eof()) {
+            error = "Invalid DIMACS clause: " + line;
+            return false;
+        }
+    }
+    if (!has_header) {
+        error = "Missing DIMACS header";
+        return false;
+    }
+    if (!clause.empty()) {
+        formula.addClause(clause); // Последняя клауза без завершающего нуля
+    }
+    formula.num_vars = declared_vars;
+    return true;
+}
+
+void writeDimacs(std::ostream& out, const CnfFormula& formula, const std::string& comment)
+{
+    if (!comment.empty()) {
+        out << "c " << comment << "\n";
+    }
+    out << "p cnf " << formula.num_vars << " " << formula.clauses.size() << "\n";
+    for (ClauseDatabase::Clause clause : formula.clauses) {
+        for (int literal : clause) {
+            out << literal << " ";
+        }
+        out << "0\n";
+    }
+}
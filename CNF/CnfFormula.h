@@ -0,0 +1,27 @@
+#ifndef CNFFORMULA_H
+#define CNFFORMULA_H
+
+#include <vector>
+#include <string>
+#include <istream>
+#include <ostream>
+#include "ClauseDatabase.h"
+
+// Формула в КНФ в нумерации DIMACS: переменные 1..num_vars,
+// литерал v — переменная v, литерал -v — ее отрицание
+struct CnfFormula
+{
+    int num_vars = 0;
+    ClauseDatabase clauses;
+
+    // Добавить клаузу; num_vars растет до наибольшей переменной клаузы
+    void addClause(const int* literals, size_t count);
+    void addClause(const std::vector<int>& clause) { addClause(clause.data(), clause.size()); }
+    void clear();
+};
+
+// Чтение и запись в формате DIMACS CNF ("p cnf <vars> <clauses>")
+bool readDimacs(std::istream& in, CnfFormula& formula, std::string& error);
+void writeDimacs(std::ostream& out, const CnfFormula& formula, const std::string& comment = std::string());
+
+#endif // CNFFORMULA_H
@@ -0,0 +1,267 @@
+#include "DpllBackend.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Литерал кодируется как 2 * переменная + знак (переменные с нуля)
+class DpllEngine
+{
+public:
+    DpllEngine(const CnfFormula& formula, bool positive_first, const std::atomic<bool>& interrupted,
+               const SolveBudget& budget);
+    SolveResult run(std::vector<bool>* model);
+    // run() вернул Unknown из-за бюджета
+    bool exhausted() const { return exhausted_; }
+    SolveStats stats() const;
+
+private:
+    struct Level {
+        size_t trail_start;     // Начало уровня в трейле (первым идет литерал решения)
+        bool flipped;           // Противоположная ветка уже пробуется
+    };
+
+    int num_vars_;
+    int decision_sign_;                         // 0 — сначала истина, 1 — сначала ложь
+    const std::atomic<bool>& interrupted_;
+    SolveBudget budget_;
+    int64_t decisions_;
+    int64_t conflicts_;
+    int64_t propagations_;
+    bool exhausted_;
+    bool conflict_;                             // Противоречие найдено при загрузке
+    ClauseDatabase clauses_;
+    std::vector<std::vector<int>> watches_;     // Литерал -> клаузы, наблюдающие его
+    std::vector<signed char> values_;           // Переменная -> -1 (нет), 0, 1
+    std::vector<int> trail_;
+    size_t propagate_head_;
+    std::vector<Level> levels_;
+    int next_var_;                              // Все переменные ниже заняты
+
+    int literalValue(int literal) const {
+        int value = values_[literal >> 1];
+        return value < 0 ? -1 : (value ^ (literal & 1));
+    }
+    void assign(int literal);
+    bool propagate();
+    void undoTo(size_t trail_size);
+};
+
+DpllEngine::DpllEngine(const CnfFormula& formula, bool positive_first, const std::atomic<bool>& interrupted,
+                       const SolveBudget& budget)
+    : num_vars_(formula.num_vars),
+    decision_sign_(positive_first ? 0 : 1),
+    interrupted_(interrupted),
+    budget_(budget),
+    decisions_(0),
+    conflicts_(0),
+    propagations_(0),
+    exhausted_(false),
+    conflict_(false),
+    watches_(static_cast<size_t>(formula.num_vars) * 2),
+    values_(formula.num_vars, -1),
+    propagate_head_(0),
+    next_var_(0)
+{
+    clauses_.reserve(formula.clauses.size(), formula.clauses.literalCount());
+    std::vector<int> clause;
+    for (ClauseDatabase::Clause source : formula.clauses) {
+        clause.clear();
+        for (int literal : source) {
+            clause.push_back((std::abs(literal) - 1) * 2 + (literal < 0 ? 1 : 0));
+        }
+        // Убираем повторы; клаузы с x и ¬x всегда истинны
+        std::sort(clause.begin(), clause.end());
+        clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+        bool tautology = false;
+        for (size_t i = 1; i < clause.size(); ++i) {
+            if ((clause[i] ^ 1) == clause[i - 1]) {
+                tautology = true;
+                break;
+            }
+        }
+        if (tautology) {
+            continue;
+        }
+        if (clause.empty()) {
+            conflict_ = true;
+        } else if (clause.size() == 1) {
+            int value = literalValue(clause[0]);
+            if (value == 0) {
+                conflict_ = true;
+            } else if (value < 0) {
+                assign(clause[0]);
+            }
+        } else {
+            int index = static_cast<int>(clauses_.size());
+            watches_[clause[0]].push_back(index);
+            watches_[clause[1]].push_back(index);
+            clauses_.add(clause);
+        }
+    }
+}
+
+void DpllEngine::assign(int literal)
+{
+    values_[literal >> 1] = static_cast<signed char>((literal & 1) ^ 1);
+    trail_.push_back(literal);
+}
+
+bool DpllEngine::propagate()
+{
+    while (propagate_head_ < trail_.size()) {
+        int false_literal = trail_[propagate_head_++] ^ 1;
+        ++propagations_;
+        std::vector<int>& watchers = watches_[false_literal];
+        size_t read = 0;
+        size_t write = 0;
+        while (read < watchers.size()) {
+            int index = watchers[read++];
+            int* clause = clauses_.mutableLiterals(index);
+            const size_t clause_size = clauses_[index].size();
+            if (clause[0] == false_literal) {
+                std::swap(clause[0], clause[1]);
+            }
+            if (literalValue(clause[0]) == 1) {
+                watchers[write++] = index;
+                continue;
+            }
+            // Ищем замену ставшему ложным наблюдаемому литералу
+            bool moved = false;
+            for (size_t k = 2; k < clause_size; ++k) {
+                if (literalValue(clause[k]) != 0) {
+                    std::swap(clause[1], clause[k]);
+                    watches_[clause[1]].push_back(index);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) {
+                continue;
+            }
+            watchers[write++] = index;
+            if (literalValue(clause[0]) == 0) {
+                while (read < watchers.size()) {
+                    watchers[write++] = watchers[read++];
+                }
+                watchers.resize(write);
+                return false;
+            }
+            assign(clause[0]);
+        }
+        watchers.resize(write);
+    }
+    return true;
+}
+
+void DpllEngine::undoTo(size_t trail_size)
+{
+    while (trail_.size() > trail_size) {
+        int variable = trail_.back() >> 1;
+        values_[variable] = -1;
+        next_var_ = std::min(next_var_, variable);
+        trail_.pop_back();
+    }
+    propagate_head_ = trail_.size();
+}
+
+SolveResult DpllEngine::run(std::vector<bool>* model)
+{
+    if (conflict_) {
+        return SolveResult::Unsat;
+    }
+    for (;;) {
+        if (interrupted_) {
+            return SolveResult::Unknown;
+        }
+        if ((budget_.conflicts > 0 && conflicts_ >= budget_.conflicts)
+            || (budget_.propagations > 0 && propagations_ >= budget_.propagations)) {
+            exhausted_ = true;
+            return SolveResult::Unknown;
+        }
+        if (!propagate()) {
+            ++conflicts_;
+            // Откат к последнему решению, для которого не пробовалась вторая ветка
+            while (!levels_.empty() && levels_.back().flipped) {
+                undoTo(levels_.back().trail_start);
+                levels_.pop_back();
+            }
+            if (levels_.empty()) {
+                return SolveResult::Unsat;
+            }
+            Level& level = levels_.back();
+            int decision = trail_[level.trail_start];
+            undoTo(level.trail_start);
+            level.flipped = true;
+            assign(decision ^ 1);
+            continue;
+        }
+        while (next_var_ < num_vars_ && values_[next_var_] >= 0) {
+            next_var_++;
+        }
+        if (next_var_ == num_vars_) {
+            break;
+        }
+        // По умолчанию сначала пробуем ложное значение, как Minisat
+        levels_.push_back({trail_.size(), false});
+        assign(next_var_ * 2 + decision_sign_);
+        ++decisions_;
+    }
+    if (model) {
+        model->assign(num_vars_ + 1, false);
+        for (int v = 0; v < num_vars_; ++v) {
+            (*model)[v + 1] = values_[v] == 1;
+        }
+    }
+    return SolveResult::Sat;
+}
+
+SolveStats DpllEngine::stats() const
+{
+    SolveStats stats;
+    stats.decisions = decisions_;
+    stats.conflicts = conflicts_;
+    stats.propagations = propagations_;
+    return stats;
+}
+
+} // namespace
+
+DpllBackend::DpllBackend()
+    : spec_("dpll")
+{
+}
+
+DpllBackend::DpllBackend(const Options& options, const std::string& spec)
+    : options_(options), spec_(spec)
+{
+}
+
+bool DpllBackend::parseOptions(const std::string& text, Options& options, std::string& error)
+{
+    std::vector<std::pair<std::string, std::string>> pairs;
+    if (!splitOptions(text, pairs, error)) {
+        return false;
+    }
+    for (const auto& option : pairs) {
+        if (option.first == "polarity" && (option.second == "pos" || option.second == "neg")) {
+            options.positive_first = option.second == "pos";
+        } else {
+            error = "Invalid dpll option: " + option.first + "=" + option.second;
+            return false;
+        }
+    }
+    return true;
+}
+
+SolveResult DpllBackend::solve(const CnfFormula& formula, std::vector<bool>* model)
+{
+    DpllEngine engine(formula, options_.positive_first, interrupted_, budget_);
+    SolveResult result = engine.run(model);
+    budget_exhausted_ = engine.exhausted();
+    last_stats_ = engine.stats();
+    if (result == SolveResult::Unknown) {
+        last_error_ = budget_exhausted_ ? "Budget exhausted" : "Interrupted";
+    }
+    return result;
+}
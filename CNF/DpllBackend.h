@@ -0,0 +1,29 @@
+#ifndef DPLLBACKEND_H
+#define DPLLBACKEND_H
+
+#include "SolverBackend.h"
+
+// Встроенный решатель: DPLL с распространением единичных клауз по двум
+// наблюдаемым литералам и хронологическим откатом. Не требует внешних
+// библиотек и подходит для небольших формул деревьев.
+class DpllBackend : public SolverBackend
+{
+public:
+    struct Options {
+        bool positive_first = false;    // polarity=pos|neg: знак, пробуемый первым
+    };
+
+    DpllBackend();
+    DpllBackend(const Options& options, const std::string& spec);
+
+    std::string name() const override { return spec_; }
+    SolveResult solve(const CnfFormula& formula, std::vector<bool>* model) override;
+
+    static bool parseOptions(const std::string& text, Options& options, std::string& error);
+
+private:
+    Options options_;
+    std::string spec_;
+};
+
+#endif // DPLLBACKEND_H
@@ -0,0 +1,239 @@
+#include "ExternalBackend.h"
+#include <sstream>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <ctime>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+namespace {
+
+// Обмен с решателем: формула пишется в input_fd, вывод читается из output_fd до конца.
+// Запись и чтение чередуются через poll: решатель может печатать (баннер, строки "c")
+// еще до конца чтения формулы, и при последовательном обмене обе стороны встали бы
+// на полных каналах. input_fd закрывается здесь же — решатель должен увидеть конец
+// формулы. Решатель может закрыть stdin, не дочитав формулу: SIGPIPE блокируется
+// только в текущем потоке (как MSG_NOSIGNAL у сокетов), а сигнал, оставшийся после
+// EPIPE, забирается, чтобы не прийти позже. Возвращает, записана ли формула целиком
+bool exchange(int input_fd, const std::string& input, int output_fd, std::string& output)
+{
+    sigset_t pipe_set;
+    sigset_t old_set;
+    sigemptyset(&pipe_set);
+    sigaddset(&pipe_set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipe_set, &old_set);
+    // Сигнал, ожидавший до записи, не наш и остается на месте
+    sigset_t pending;
+    sigpending(&pending);
+    const bool was_pending = sigismember(&pending, SIGPIPE) == 1;
+
+    // Неблокирующая запись: poll сообщает о свободном месте, но не о его размере
+    fcntl(input_fd, F_SETFL, fcntl(input_fd, F_GETFL) | O_NONBLOCK);
+    bool written = false;
+    bool broken_pipe = false;
+    size_t offset = 0;
+    char buffer[65536];
+    bool reading = true;
+    while (reading) {
+        pollfd fds[2];
+        nfds_t count = 0;
+        if (input_fd >= 0) {
+            fds[count++] = {input_fd, POLLOUT, 0};
+        }
+        fds[count++] = {output_fd, POLLIN, 0};
+        if (poll(fds, count, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (input_fd >= 0 && fds[0].revents != 0) {
+            ssize_t n = ::write(input_fd, input.data() + offset, input.size() - offset);
+            const bool failed = n < 0 && errno != EINTR && errno != EAGAIN;
+            broken_pipe = failed && errno == EPIPE;
+            if (n > 0) {
+                offset += static_cast<size_t>(n);
+            }
+            if (failed || offset == input.size()) {
+                written = !failed;
+                close(input_fd);
+                input_fd = -1;
+            }
+        }
+        if (fds[count - 1].revents != 0) {
+            ssize_t n = ::read(output_fd, buffer, sizeof(buffer));
+            if (n > 0) {
+                output.append(buffer, static_cast<size_t>(n));
+            } else if (n == 0 || (errno != EINTR && errno != EAGAIN)) {
+                reading = false;
+            }
+        }
+    }
+    if (input_fd >= 0) {
+        close(input_fd);
+    }
+
+    if (broken_pipe && !was_pending) {
+        const timespec no_wait = {0, 0};
+        while (sigtimedwait(&pipe_set, nullptr, &no_wait) < 0 && errno == EINTR) {
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &old_set, nullptr);
+    return written;
+}
+
+} // namespace
+
+ExternalBackend::ExternalBackend(const std::vector<std::string>& command)
+    : command_(command), child_(0)
+{
+}
+
+std::string ExternalBackend::name() const
+{
+    return "external:" + (command_.empty() ? std::string() : command_.front());
+}
+
+SolveResult ExternalBackend::solve(const CnfFormula& formula, std::vector<bool>* model)
+{
+    last_error_.clear();
+    std::ostringstream dimacs;
+    writeDimacs(dimacs, formula);
+
+    // Аргументы готовятся до fork: в дочернем процессе многопоточной программы
+    // допустимы только async-signal-safe вызовы
+    std::vector<char*> argv;
+    for (const std::string& arg : command_) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    // O_CLOEXEC: решатели, запускаемые другими потоками, не наследуют чужие концы
+    // каналов (иначе решатель не увидел бы конца ввода)
+    int to_child[2];
+    int from_child[2];
+    if (pipe2(to_child, O_CLOEXEC) != 0) {
+        last_error_ = "Failed to create pipe";
+        return SolveResult::Unknown;
+    }
+    if (pipe2(from_child, O_CLOEXEC) != 0) {
+        close(to_child[0]);
+        close(to_child[1]);
+        last_error_ = "Failed to create pipe";
+        return SolveResult::Unknown;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(to_child[0]);
+        close(to_child[1]);
+        close(from_child[0]);
+        close(from_child[1]);
+        last_error_ = "Failed to start external solver";
+        return SolveResult::Unknown;
+    }
+    if (pid == 0) {
+        // dup2 снимает O_CLOEXEC с копий, остальные концы закроет exec
+        dup2(to_child[0], STDIN_FILENO);
+        dup2(from_child[1], STDOUT_FILENO);
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+
+    close(to_child[0]);
+    close(from_child[1]);
+    {
+        std::lock_guard<std::mutex> lock(child_mutex_);
+        child_ = pid;
+        // Прерывание могло прийти до запуска процесса
+        if (interrupted_) {
+            kill(pid, SIGTERM);
+        }
+    }
+    std::string output;
+    const bool written = exchange(to_child[1], dimacs.str(), from_child[0], output);
+    close(from_child[0]);
+
+    int status = 0;
+    // Ждем завершения, не забирая статус: pid остается занятым, пока interrupt
+    // может послать ему сигнал, и освобождается уже под блокировкой
+    siginfo_t info;
+    while (waitid(P_PID, static_cast<id_t>(pid), &info, WEXITED | WNOWAIT) < 0 && errno == EINTR) {
+    }
+    {
+        std::lock_guard<std::mutex> lock(child_mutex_);
+        while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+        }
+        child_ = 0;
+    }
+    if (interrupted_) {
+        last_error_ = "Interrupted";
+        return SolveResult::Unknown;
+    }
+    int exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    if (exit_code == 127) {
+        last_error_ = "Failed to execute external solver: " + command_.front();
+        return SolveResult::Unknown;
+    }
+
+    SolveResult result = parseOutput(output, exit_code, formula.num_vars, model);
+    if (result == SolveResult::Unknown) {
+        last_error_ = written ? "External solver gave no answer" : "External solver did not read the formula";
+    }
+    return result;
+}
+
+void ExternalBackend::interrupt()
+{
+    SolverBackend::interrupt();
+    std::lock_guard<std::mutex> lock(child_mutex_);
+    if (child_ > 0) {
+        kill(child_, SIGTERM);
+    }
+}
+
+SolveResult ExternalBackend::parseOutput(const std::string& output, int exit_code,
+                                         int num_vars, std::vector<bool>* model)
+{
+    SolveResult result = SolveResult::Unknown;
+    if (model) {
+        model->assign(num_vars + 1, false);
+    }
+    std::istringstream lines(output);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::istringstream tokens(line);
+        std::string first;
+        if (!(tokens >> first)) {
+            continue;
+        }
+        if (first == "s") {
+            tokens >> first;
+        }
+        if (first == "SATISFIABLE" || first == "SAT") {
+            result = SolveResult::Sat;
+        } else if (first == "UNSATISFIABLE" || first == "UNSAT") {
+            result = SolveResult::Unsat;
+        } else if (first == "v" && model) {
+            long literal = 0;
+            while (tokens >> literal) {
+                if (literal > 0 && literal <= num_vars) {
+                    (*model)[literal] = true;
+                }
+            }
+        }
+    }
+    if (result == SolveResult::Unknown) {
+        // Соглашение SAT-соревнований о кодах завершения
+        if (exit_code == 10) {
+            result = SolveResult::Sat;
+        } else if (exit_code == 20) {
+            result = SolveResult::Unsat;
+        }
+    }
+    return result;
+}
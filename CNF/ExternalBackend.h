@@ -0,0 +1,32 @@
+#ifndef EXTERNALBACKEND_H
+#define EXTERNALBACKEND_H
+
+#include <mutex>
+#include <sys/types.h>
+#include "SolverBackend.h"
+
+// Внешний решатель: программа запускается для каждой формулы, получает
+// ее в DIMACS через stdin и отвечает в формате SAT-соревнований
+// ("s SATISFIABLE" / "s UNSATISFIABLE" и строки "v ... 0") или кодом
+// завершения 10/20. Используются каналы POSIX (fork/exec).
+class ExternalBackend : public SolverBackend
+{
+public:
+    explicit ExternalBackend(const std::vector<std::string>& command);
+
+    std::string name() const override;
+    SolveResult solve(const CnfFormula& formula, std::vector<bool>* model) override;
+    // Завершает запущенный процесс решателя
+    void interrupt() override;
+
+    // Разбор ответа решателя; exit_code учитывается, если в выводе нет строки результата
+    static SolveResult parseOutput(const std::string& output, int exit_code,
+                                   int num_vars, std::vector<bool>* model);
+
+private:
+    std::vector<std::string> command_;
+    std::mutex child_mutex_;
+    pid_t child_;               // Процесс текущего решения (0, если его нет)
+};
+
+#endif // EXTERNALBACKEND_H
@@ -0,0 +1,122 @@
+#include "MinisatBackend.h"
+#include <minisat/core/Solver.h>
+#include <cstdlib>
+
+MinisatBackend::MinisatBackend()
+    : spec_("minisat"), active_(nullptr)
+{
+}
+
+MinisatBackend::MinisatBackend(const Options& options, const std::string& spec)
+    : options_(options), spec_(spec), active_(nullptr)
+{
+}
+
+bool MinisatBackend::parseOptions(const std::string& text, Options& options, std::string& error)
+{
+    std::vector<std::pair<std::string, std::string>> pairs;
+    if (!splitOptions(text, pairs, error)) {
+        return false;
+    }
+    for (const auto& option : pairs) {
+        const char* value = option.second.c_str();
+        char* end = nullptr;
+        double number = std::strtod(value, &end);
+        if (end == value || *end != '\0') {
+            error = "Invalid value for minisat option '" + option.first + "': " + option.second;
+            return false;
+        }
+        if (option.first == "seed" && number > 0) {
+            options.random_seed = number;
+        } else if (option.first == "rnd-freq" && number >= 0 && number <= 1) {
+            options.random_var_freq = number;
+        } else if (option.first == "rnd-pol") {
+            options.random_polarity = number != 0;
+        } else if (option.first == "phase-saving" && number >= 0 && number <= 2) {
+            options.phase_saving = static_cast<int>(number);
+        } else if (option.first == "luby") {
+            options.luby_restart = number != 0;
+        } else {
+            error = "Invalid minisat option: " + option.first + "=" + option.second;
+            return false;
+        }
+    }
+    return true;
+}
+
+SolveResult MinisatBackend::solve(const CnfFormula& formula, std::vector<bool>* model)
+{
+    budget_exhausted_ = false;
+    last_stats_ = SolveStats();
+    Minisat::Solver solver;
+    solver.random_seed = options_.random_seed;
+    solver.random_var_freq = options_.random_var_freq;
+    solver.rnd_pol = options_.random_polarity;
+    solver.phase_saving = options_.phase_saving;
+    solver.luby_restart = options_.luby_restart;
+    for (int i = 0; i < formula.num_vars; ++i) {
+        solver.newVar();
+    }
+    Minisat::vec<Minisat::Lit> literals;
+    for (ClauseDatabase::Clause clause : formula.clauses) {
+        literals.clear();
+        for (int literal : clause) {
+            literals.push(Minisat::mkLit(std::abs(literal) - 1, literal < 0));
+        }
+        // addClause возвращает false, если формула уже противоречива
+        if (!solver.addClause(literals)) {
+            return SolveResult::Unsat;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(active_mutex_);
+        active_ = &solver;
+        // Прерывание могло прийти до начала поиска
+        if (interrupted_) {
+            solver.interrupt();
+        }
+    }
+    if (budget_.conflicts > 0) {
+        solver.setConfBudget(budget_.conflicts);
+    }
+    if (budget_.propagations > 0) {
+        solver.setPropBudget(budget_.propagations);
+    }
+    // solveLimited отличает прерывание и исчерпание бюджета (l_Undef) от UNSAT,
+    // в отличие от solve()
+    Minisat::vec<Minisat::Lit> assumptions;
+    Minisat::lbool answer = solver.solveLimited(assumptions);
+    {
+        std::lock_guard<std::mutex> lock(active_mutex_);
+        active_ = nullptr;
+    }
+    last_stats_.decisions = static_cast<int64_t>(solver.decisions);
+    last_stats_.conflicts = static_cast<int64_t>(solver.conflicts);
+    last_stats_.propagations = static_cast<int64_t>(solver.propagations);
+
+    if (answer == l_False) {
+        return SolveResult::Unsat;
+    }
+    if (answer != l_True) {
+        budget_exhausted_ = !interrupted_;
+        last_error_ = budget_exhausted_ ? "Budget exhausted" : "Interrupted";
+        return SolveResult::Unknown;
+    }
+    if (model) {
+        model->assign(formula.num_vars + 1, false);
+        for (int v = 1; v <= formula.num_vars; ++v) {
+            (*model)[v] = solver.modelValue(v - 1) == l_True;
+        }
+    }
+    return SolveResult::Sat;
+}
+
+void MinisatBackend::interrupt()
+{
+    SolverBackend::interrupt();
+    std::lock_guard<std::mutex> lock(active_mutex_);
+    if (active_) {
+        active_->interrupt();
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef MINISATBACKEND_H
+#define MINISATBACKEND_H
+
+#include <mutex>
+#include "SolverBackend.h"
+
+namespace Minisat { class Solver; }
+
+// Решатель на основе библиотеки Minisat
+class MinisatBackend : public SolverBackend
+{
+public:
+    // Настройки поиска (соответствуют одноименным полям Minisat::Solver)
+    struct Options {
+        double random_seed = 91648253;  // seed
+        double random_var_freq = 0;     // rnd-freq: доля случайных решений
+        bool random_polarity = false;   // rnd-pol: случайный знак решения
+        int phase_saving = 2;           // phase-saving: 0 — нет, 1 — частично, 2 — полностью
+        bool luby_restart = true;       // luby: перезапуски Luby (0 — геометрические)
+    };
+
+    MinisatBackend();
+    MinisatBackend(const Options& options, const std::string& spec);
+
+    std::string name() const override { return spec_; }
+    SolveResult solve(const CnfFormula& formula, std::vector<bool>* model) override;
+    void interrupt() override;
+
+    static bool parseOptions(const std::string& text, Options& options, std::string& error);
+
+private:
+    Options options_;
+    std::string spec_;
+    std::mutex active_mutex_;
+    Minisat::Solver* active_;   // Решатель, работающий сейчас (для interrupt)
+};
+
+#endif // MINISATBACKEND_H
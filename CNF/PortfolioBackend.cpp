@@ -0,0 +1,128 @@
+#include "PortfolioBackend.h"
+#include <thread>
+
+std::string PortfolioBackend::defaultMembers()
+{
+    // Разные семена, знаки решений и стратегии перезапусков плюс встроенный решатель
+    return "minisat,"
+           "minisat/seed=7/rnd-pol=1/luby=0,"
+           "minisat/seed=13/rnd-freq=0.05/phase-saving=0,"
+           "dpll/polarity=pos";
+}
+
+PortfolioBackend* PortfolioBackend::create(const std::string& members, std::string& error)
+{
+    const std::string list = members == "default" ? defaultMembers() : members;
+    std::unique_ptr<PortfolioBackend> portfolio(new PortfolioBackend());
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        const std::string spec = list.substr(start, end - start);
+        if (spec.compare(0, 10, "portfolio:") == 0) {
+            error = "Nested portfolio is not supported";
+            return nullptr;
+        }
+        SolverBackend* member = SolverBackend::create(spec, error);
+        if (!member) {
+            return nullptr;
+        }
+        portfolio->members_.emplace_back(member);
+        start = end + 1;
+    }
+    if (portfolio->members_.size() < 2) {
+        error = "Portfolio needs at least two solvers";
+        return nullptr;
+    }
+    return portfolio.release();
+}
+
+std::string PortfolioBackend::name() const
+{
+    std::string result = "portfolio:";
+    for (size_t i = 0; i < members_.size(); ++i) {
+        result += (i ? "," : "") + members_[i]->name();
+    }
+    return result;
+}
+
+SolveResult PortfolioBackend::solve(const CnfFormula& formula, std::vector<bool>* model)
+{
+    last_error_.clear();
+    last_winner_.clear();
+    budget_exhausted_ = false;
+    last_stats_ = SolveStats();
+    for (auto& member : members_) {
+        member->clearInterrupt();
+    }
+    // Общий запрос прерывания портфеля передается участникам
+    if (interrupted_) {
+        last_error_ = "Interrupted";
+        return SolveResult::Unknown;
+    }
+
+    std::mutex result_mutex;
+    SolveResult result = SolveResult::Unknown;
+    std::vector<std::thread> threads;
+    threads.reserve(members_.size());
+    for (size_t i = 0; i < members_.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            std::vector<bool> member_model;
+            SolveResult member_result = members_[i]->solve(formula, model ? &member_model : nullptr);
+            if (member_result == SolveResult::Unknown) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(result_mutex);
+            if (result != SolveResult::Unknown) {
+                return; // Ответ уже получен другим участником
+            }
+            result = member_result;
+            if (model) {
+                model->swap(member_model);
+            }
+            last_winner_ = members_[i]->name();
+            for (size_t j = 0; j < members_.size(); ++j) {
+                if (j != i) {
+                    members_[j]->interrupt();
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    // Счетчики портфеля — суммарная работа всех участников, включая прерванных
+    for (auto& member : members_) {
+        last_stats_.decisions += member->lastStats().decisions;
+        last_stats_.conflicts += member->lastStats().conflicts;
+        last_stats_.propagations += member->lastStats().propagations;
+    }
+    if (result == SolveResult::Unknown) {
+        last_error_ = interrupted_ ? "Interrupted" : "No portfolio member produced an answer";
+        for (auto& member : members_) {
+            if (!member->lastError().empty() && !interrupted_) {
+                last_error_ += "; " + member->name() + ": " + member->lastError();
+            }
+            budget_exhausted_ = budget_exhausted_ || (!interrupted_ && member->budgetExhausted());
+        }
+    }
+    return result;
+}
+
+void PortfolioBackend::setBudget(const SolveBudget& budget)
+{
+    SolverBackend::setBudget(budget);
+    for (auto& member : members_) {
+        member->setBudget(budget);
+    }
+}
+
+void PortfolioBackend::interrupt()
+{
+    SolverBackend::interrupt();
+    for (auto& member : members_) {
+        member->interrupt();
+    }
+}
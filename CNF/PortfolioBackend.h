@@ -0,0 +1,34 @@
+#ifndef PORTFOLIOBACKEND_H
+#define PORTFOLIOBACKEND_H
+
+#include <memory>
+#include <mutex>
+#include "SolverBackend.h"
+
+// Портфель решателей: все участники решают одну формулу в отдельных потоках,
+// берется первый ответ SAT/UNSAT, остальные прерываются через interrupt().
+class PortfolioBackend : public SolverBackend
+{
+public:
+    // Спецификации участников через запятую; "default" — набор по умолчанию
+    static PortfolioBackend* create(const std::string& members, std::string& error);
+    static std::string defaultMembers();
+
+    std::string name() const override;
+    SolveResult solve(const CnfFormula& formula, std::vector<bool>* model) override;
+    void interrupt() override;
+    // Бюджет действует на каждого участника отдельно
+    void setBudget(const SolveBudget& budget) override;
+
+    size_t size() const { return members_.size(); }
+    // Участник, давший ответ в последнем решении (пусто, если ответа не было)
+    const std::string& lastWinner() const { return last_winner_; }
+
+private:
+    PortfolioBackend() {}
+
+    std::vector<std::unique_ptr<SolverBackend>> members_;
+    std::string last_winner_;
+};
+
+#endif // PORTFOLIOBACKEND_H
@@ -0,0 +1,64 @@
+#include "SolveWatchdog.h"
+
+SolveWatchdog::SolveWatchdog()
+    : target_(nullptr), fired_(false), stopping_(false)
+{
+}
+
+SolveWatchdog::~SolveWatchdog()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void SolveWatchdog::arm(SolverBackend* solver, Clock::time_point deadline)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        target_ = solver;
+        deadline_ = deadline;
+        fired_ = false;
+    }
+    if (!thread_.joinable()) {
+        thread_ = std::thread(&SolveWatchdog::run, this);
+    } else {
+        wake_.notify_one();
+    }
+}
+
+bool SolveWatchdog::disarm()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const bool fired = fired_;
+    // Прерывание могло прийти уже после ответа решателя; следующее решение
+    // должно начаться без него
+    if (fired && target_) {
+        target_->clearInterrupt();
+    }
+    target_ = nullptr;
+    fired_ = false;
+    return fired;
+}
+
+void SolveWatchdog::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (!target_ || fired_) {
+            wake_.wait(lock);
+            continue;
+        }
+        if (wake_.wait_until(lock, deadline_) == std::cv_status::timeout
+            && target_ && !fired_ && Clock::now() >= deadline_) {
+            // interrupt() решателей не ждет окончания поиска, поэтому вызывается под блокировкой
+            target_->interrupt();
+            fired_ = true;
+        }
+    }
+}
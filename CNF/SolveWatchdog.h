@@ -0,0 +1,39 @@
+#ifndef SOLVEWATCHDOG_H
+#define SOLVEWATCHDOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "SolverBackend.h"
+
+// Ограничение времени решения: поток наблюдения прерывает решатель через
+// interrupt(), если решение не закончилось к сроку. Поток один на все решения
+// и запускается при первом взводе
+class SolveWatchdog
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    SolveWatchdog();
+    ~SolveWatchdog();
+
+    // Прервать решатель, если до deadline не будет вызван disarm()
+    void arm(SolverBackend* solver, Clock::time_point deadline);
+    // Снять наблюдение; true, если решатель был прерван по сроку
+    // (запрос прерывания при этом снимается)
+    bool disarm();
+
+private:
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::thread thread_;
+    SolverBackend* target_;
+    Clock::time_point deadline_;
+    bool fired_;
+    bool stopping_;
+};
+
+#endif // SOLVEWATCHDOG_H
@@ -0,0 +1,85 @@
+#include "SolverBackend.h"
+#include "MinisatBackend.h"
+#include "DpllBackend.h"
+#include "ExternalBackend.h"
+#include "PortfolioBackend.h"
+#include <sstream>
+
+const char* solveResultName(SolveResult result)
+{
+    switch (result) {
+    case SolveResult::Sat: return "SAT";
+    case SolveResult::Unsat: return "UNSAT";
+    default: return "UNKNOWN";
+    }
+}
+
+SolverBackend* SolverBackend::create(const std::string& spec, std::string& error)
+{
+    const std::string portfolio_prefix = "portfolio:";
+    if (spec.compare(0, portfolio_prefix.size(), portfolio_prefix) == 0) {
+        return PortfolioBackend::create(spec.substr(portfolio_prefix.size()), error);
+    }
+    // Имя и опции встроенных решателей: "minisat/seed=7/luby=0"
+    const std::string base = spec.substr(0, spec.find('/'));
+    const std::string options = base.size() < spec.size() ? spec.substr(base.size() + 1) : std::string();
+    if (base == "minisat") {
+        MinisatBackend::Options minisat_options;
+        if (!MinisatBackend::parseOptions(options, minisat_options, error)) {
+            return nullptr;
+        }
+        return new MinisatBackend(minisat_options, spec);
+    }
+    if (base == "dpll") {
+        DpllBackend::Options dpll_options;
+        if (!DpllBackend::parseOptions(options, dpll_options, error)) {
+            return nullptr;
+        }
+        return new DpllBackend(dpll_options, spec);
+    }
+    const std::string external_prefix = "external:";
+    if (spec.compare(0, external_prefix.size(), external_prefix) == 0) {
+        // Команда разбивается по пробелам: первый элемент — программа, остальные — аргументы
+        std::istringstream tokens(spec.substr(external_prefix.size()));
+        std::vector<std::string> command;
+        std::string token;
+        while (tokens >> token) {
+            command.push_back(token);
+        }
+        if (command.empty()) {
+            error = "External solver command is empty";
+            return nullptr;
+        }
+        return new ExternalBackend(command);
+    }
+    error = "Unknown solver backend: " + spec;
+    return nullptr;
+}
+
+bool SolverBackend::splitOptions(const std::string& options,
+                                 std::vector<std::pair<std::string, std::string>>& pairs,
+                                 std::string& error)
+{
+    pairs.clear();
+    size_t start = 0;
+    while (start < options.size()) {
+        size_t end = options.find('/', start);
+        if (end == std::string::npos) {
+            end = options.size();
+        }
+        const std::string item = options.substr(start, end - start);
+        size_t equals = item.find('=');
+        if (equals == std::string::npos || equals == 0) {
+            error = "Invalid solver option: " + item;
+            return false;
+        }
+        pairs.emplace_back(item.substr(0, equals), item.substr(equals + 1));
+        start = end + 1;
+    }
+    return true;
+}
+
+std::vector<std::string> SolverBackend::builtinNames()
+{
+    return {"minisat", "dpll"};
+}
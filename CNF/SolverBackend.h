@@ -0,0 +1,85 @@
+#ifndef SOLVERBACKEND_H
+#define SOLVERBACKEND_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include "CnfFormula.h"
+
+// Результат решения формулы
+enum class SolveResult {
+    Sat,
+    Unsat,
+    Unknown     // Решатель не дал ответа (ошибка запуска, обрыв вывода)
+};
+
+const char* solveResultName(SolveResult result);
+
+// Бюджет одного решения (0 — без ограничения). Решение, исчерпавшее бюджет,
+// возвращает Unknown
+struct SolveBudget {
+    int64_t conflicts = 0;      // Число конфликтов
+    int64_t propagations = 0;   // Число распространенных литералов
+};
+
+// Счетчики поиска одного решения. Решатели, не сообщающие счетчиков (external),
+// оставляют нули
+struct SolveStats {
+    int64_t decisions = 0;
+    int64_t conflicts = 0;
+    int64_t propagations = 0;
+};
+
+// Интерфейс решателя КНФ. Реализации: minisat (библиотека Minisat),
+// dpll (встроенный решатель), external:<команда> (внешняя программа,
+// формула передается в DIMACS через stdin, ответ читается из stdout)
+// и portfolio:<спецификация>,... (гонка нескольких решателей в потоках).
+// Настройки реализации передаются после имени через '/': "minisat/seed=7/luby=0".
+class SolverBackend
+{
+public:
+    virtual ~SolverBackend() {}
+
+    virtual std::string name() const = 0;
+    // При Sat и model != nullptr (*model)[v] — значение переменной v (1..num_vars),
+    // (*model)[0] не используется. Без model решатель не тратит время на извлечение модели.
+    virtual SolveResult solve(const CnfFormula& formula, std::vector<bool>* model) = 0;
+
+    // Описание последней ошибки (для Unknown)
+    const std::string& lastError() const { return last_error_; }
+
+    // Счетчики последнего решения (обнуляются в начале каждого solve)
+    const SolveStats& lastStats() const { return last_stats_; }
+
+    // Бюджет следующих решений. external его не поддерживает: внешнюю программу
+    // ограничивает только interrupt()
+    virtual void setBudget(const SolveBudget& budget) { budget_ = budget; }
+    const SolveBudget& budget() const { return budget_; }
+    // Последний Unknown вызван исчерпанием бюджета, а не ошибкой или прерыванием
+    bool budgetExhausted() const { return budget_exhausted_; }
+
+    // Прервать решение из другого потока: solve вернет Unknown. Запрос действует,
+    // пока не вызван clearInterrupt(), в том числе если решение еще не началось.
+    virtual void interrupt() { interrupted_ = true; }
+    void clearInterrupt() { interrupted_ = false; }
+    bool isInterrupted() const { return interrupted_; }
+
+    // Создать решатель по спецификации: "minisat[/опции]", "dpll[/опции]",
+    // "external:<команда с аргументами>" или "portfolio:<спецификация>,<спецификация>,..."
+    static SolverBackend* create(const std::string& spec, std::string& error);
+    static std::vector<std::string> builtinNames();
+
+protected:
+    std::string last_error_;
+    std::atomic<bool> interrupted_{false};
+    SolveBudget budget_;
+    bool budget_exhausted_ = false;
+    SolveStats last_stats_;
+
+    // Разбор опций "ключ=значение" после имени решателя
+    static bool splitOptions(const std::string& options, std::vector<std::pair<std::string, std::string>>& pairs,
+                             std::string& error);
+};
+
+#endif // SOLVERBACKEND_H
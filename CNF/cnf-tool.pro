@@ -0,0 +1,30 @@
+# Отдельная утилита для формул деревьев: DIMACS, решатели, сравнение решателей
+CONFIG += c++17 console thread
+CONFIG -= qt app_bundle
+TEMPLATE = app
+
+TARGET = cnf-tool
+
+INCLUDEPATH += /usr/local/include
+LIBS += -L/usr/local/lib -lminisat
+
+SOURCES += \
+    BoolVector.cpp \
+    ClauseDatabase.cpp \
+    CnfFormula.cpp \
+    DpllBackend.cpp \
+    ExternalBackend.cpp \
+    MinisatBackend.cpp \
+    PortfolioBackend.cpp \
+    SolverBackend.cpp \
+    main.cpp
+
+HEADERS += \
+    BoolVector.h \
+    ClauseDatabase.h \
+    CnfFormula.h \
+    DpllBackend.h \
+    ExternalBackend.h \
+    MinisatBackend.h \
+    PortfolioBackend.h \
+    SolverBackend.h
@@ -0,0 +1,195 @@
+// cnf-tool: работа с формулами деревьев вне анализатора.
+// Формула задается либо в DIMACS, либо строками "<положительные биты> <отрицательные биты>"
+// (как векторы соединений: бит i соответствует переменной x_i).
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <memory>
+#include <cstdlib>
+#include "CnfFormula.h"
+#include "SolverBackend.h"
+
+static void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " to-dimacs <vectors_file> [dimacs_file]" << std::endl;
+    std::cout << "       " << program << " from-dimacs <dimacs_file>" << std::endl;
+    std::cout << "       " << program << " solve [--solver <spec>] <dimacs_file>" << std::endl;
+    std::cout << "       " << program << " bench [--solver <spec>]... <dimacs_file>" << std::endl;
+    std::cout << "Solvers: minisat[/options], dpll[/options], external:<command>, portfolio:<spec>,<spec>,..." << std::endl;
+}
+
+static bool loadDimacs(const std::string& path, CnfFormula& formula)
+{
+    std::ifstream in(path);
+    if (!in) {
+        std::cout << "Error: Failed to open file: " << path << std::endl;
+        return false;
+    }
+    std::string error;
+    if (!readDimacs(in, formula, error)) {
+        std::cout << "Error: " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Чтение строк с парами битовых векторов: символ i вектора — переменная i + 1
+static bool loadVectors(const std::string& path, CnfFormula& formula)
+{
+    std::ifstream in(path);
+    if (!in) {
+        std::cout << "Error: Failed to open file: " << path << std::endl;
+        return false;
+    }
+    formula.clear();
+    std::vector<int> clause;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+        line_number++;
+        std::istringstream tokens(line);
+        std::string positive;
+        std::string negative;
+        if (!(tokens >> positive)) {
+            continue;
+        }
+        if (!(tokens >> negative) ||
+            positive.find_first_not_of("01") != std::string::npos ||
+            negative.find_first_not_of("01") != std::string::npos) {
+            std::cout << "Error: Invalid clause at line " << line_number << std::endl;
+            return false;
+        }
+        clause.clear();
+        for (size_t i = 0; i < positive.size(); ++i) {
+            if (positive[i] == '1') {
+                clause.push_back(static_cast<int>(i) + 1);
+            }
+        }
+        for (size_t i = 0; i < negative.size(); ++i) {
+            if (negative[i] == '1') {
+                clause.push_back(-(static_cast<int>(i) + 1));
+            }
+        }
+        formula.addClause(clause);
+    }
+    return true;
+}
+
+// Клауза как пара битовых векторов ширины формулы
+static void printVectors(ClauseDatabase::Clause clause, int width)
+{
+    std::string positive(width, '0');
+    std::string negative(width, '0');
+    for (int literal : clause) {
+        (literal > 0 ? positive : negative)[std::abs(literal) - 1] = '1';
+    }
+    std::cout << positive << " " << negative << std::endl;
+}
+
+static int solveCommand(const std::vector<std::string>& specs, const std::string& path, bool bench)
+{
+    CnfFormula formula;
+    if (!loadDimacs(path, formula)) {
+        return 1;
+    }
+    int exit_code = 0;
+    for (const std::string& spec : specs) {
+        std::string error;
+        std::unique_ptr<SolverBackend> solver(SolverBackend::create(spec, error));
+        if (!solver) {
+            std::cout << "Error: " << error << std::endl;
+            return 1;
+        }
+        std::vector<bool> model;
+        auto start = std::chrono::steady_clock::now();
+        SolveResult result = solver->solve(formula, bench ? nullptr : &model);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (bench) {
+            std::cout << solver->name() << ": " << solveResultName(result) << " in " << ms << " ms" << std::endl;
+            continue;
+        }
+        // Ответ в формате SAT-соревнований
+        if (result == SolveResult::Sat) {
+            std::cout << "s SATISFIABLE" << std::endl << "v";
+            for (int v = 1; v <= formula.num_vars; ++v) {
+                std::cout << " " << (model[v] ? v : -v);
+            }
+            std::cout << " 0" << std::endl;
+            exit_code = 10;
+        } else if (result == SolveResult::Unsat) {
+            std::cout << "s UNSATISFIABLE" << std::endl;
+            exit_code = 20;
+        } else {
+            std::cout << "s UNKNOWN" << std::endl;
+            std::cout << "c " << solver->lastError() << std::endl;
+        }
+    }
+    return exit_code;
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    const std::string command = args[0];
+
+    if (command == "to-dimacs" && (args.size() == 2 || args.size() == 3)) {
+        CnfFormula formula;
+        if (!loadVectors(args[1], formula)) {
+            return 1;
+        }
+        if (args.size() == 3) {
+            std::ofstream out(args[2]);
+            if (!out) {
+                std::cout << "Error: Failed to open file: " << args[2] << std::endl;
+                return 1;
+            }
+            writeDimacs(out, formula, "converted from " + args[1]);
+        } else {
+            writeDimacs(std::cout, formula);
+        }
+        return 0;
+    }
+
+    if (command == "from-dimacs" && args.size() == 2) {
+        CnfFormula formula;
+        if (!loadDimacs(args[1], formula)) {
+            return 1;
+        }
+        for (ClauseDatabase::Clause clause : formula.clauses) {
+            printVectors(clause, formula.num_vars);
+        }
+        return 0;
+    }
+
+    if (command == "solve" || command == "bench") {
+        std::vector<std::string> specs;
+        std::string path;
+        for (size_t i = 1; i < args.size(); ++i) {
+            if (args[i] == "--solver" && i + 1 < args.size()) {
+                specs.push_back(args[++i]);
+            } else if (path.empty()) {
+                path = args[i];
+            } else {
+                path.clear();
+                break;
+            }
+        }
+        bool bench = command == "bench";
+        if (path.empty() || (!bench && specs.size() > 1)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (specs.empty()) {
+            specs = bench ? SolverBackend::builtinNames() : std::vector<std::string>{"minisat"};
+        }
+        return solveCommand(specs, path, bench);
+    }
+
+    printUsage(argv[0]);
+    return 1;
+}
@@ -1,158 +0,0 @@
-#include "CNFNode.h"
-#include <stdio.h>
-#include <iostream>
-#include <string.h>
-CNFNode::CNFNode()
-    : positiveVars(),  // Явный вызов конструктора по умолчанию BoolVector
-    negativeVars(),  // Явный вызов конструктора по умолчанию BoolVector
-    next(nullptr)    // Инициализация указателя как nullptr
-{
-}
-
-
-CNFNode::CNFNode(size_t bits)
-    : positiveVars(bits),  // Явный вызов конструктора по умолчанию BoolVector
-    negativeVars(bits),  // Явный вызов конструктора по умолчанию BoolVector
-    next(nullptr)    // Инициализация указателя как nullptr
-{
-}
-
-CNFNode::~CNFNode() {
-    if (next) delete next;
-}
-
-void CNFNode::print() const {
-    const CNFNode* current = this;  // Начинаем с текущей клаузы
-    size_t clause_num = 1;           // Номер текущей клаузы
-
-    while (current != nullptr) {      // Пока не дошли до конца списка
-        printf("Clause %zu:\n", clause_num++);
-        printf("  Positive vars: ");
-        current->positiveVars.print();
-        printf("  Negative vars: ");
-        current->negativeVars.print();
-        printf("\n");
-
-        current = current->next;     // Переходим к следующей клаузе
-    }
-}
-
-void CNFNode::setPositiveBit(size_t position, const QString& varType, size_t& max_bytes) {
-    // Определяем новый размер в зависимости от типа
-    size_t size_increment = (varType == "variable") ? 1 : 2;
-    size_t new_bits = position + size_increment;
-    size_t required_bytes = ((new_bits) / 8) + 1;
-
-    // Проверяем и расширяем при необходимости
-    if (required_bytes > positiveVars.bytes || positiveVars.bits == 0) {
-        if (required_bytes > max_bytes) {
-            max_bytes = required_bytes;
-        }
-        positiveVars.resize(new_bits);
-        negativeVars.resizeBytes(max_bytes);
-    }
-
-    // Устанавливаем бит
-    positiveVars.setBit(position);
-}
-
-void CNFNode::setNegativeBit(size_t position, const QString& varType, size_t& max_bytes) {
-
-    size_t size_increment = (varType == "variable") ? 1 : 2;
-    size_t new_bits = position + size_increment;
-    size_t required_bytes = ((new_bits) / 8) + 1;
-
-    if (required_bytes > negativeVars.bytes || negativeVars.bits == 0) {
-        if (required_bytes > max_bytes) {
-            max_bytes = required_bytes;
-        }
-        negativeVars.resize(new_bits);
-        positiveVars.resizeBytes(max_bytes);
-    }
-
-    negativeVars.setBit(position);
-}
-
-void CNFNode::clearPositiveBit(size_t position, const QString& varType, size_t& max_bytes) {
-    size_t size_increment = (varType == "variable") ? 1 : 2;
-    size_t new_bits = position + size_increment;
-    size_t required_bytes = ((new_bits) / 8) + 1;
-
-    if (required_bytes > positiveVars.bytes || positiveVars.bits == 0) {
-        if (required_bytes > max_bytes) {
-            max_bytes = required_bytes;
-        }
-        positiveVars.resize(new_bits);
-        negativeVars.resizeBytes(max_bytes);
-    }
-
-    positiveVars.clearBit(position);
-}
-
-void CNFNode::clearNegativeBit(size_t position, const QString& varType, size_t& max_bytes) {
-    size_t size_increment = (varType == "variable") ? 1 : 2;
-    size_t new_bits = position + size_increment;
-    size_t required_bytes = ((new_bits) / 8) + 1;
-
-    if (required_bytes > negativeVars.bytes || negativeVars.bits == 0) {
-        if (required_bytes > max_bytes) {
-            max_bytes = required_bytes;
-        }
-        negativeVars.resize(new_bits);
-                        positiveVars.resizeBytes(max_bytes);
-    }
-
-    negativeVars.clearBit(position);
-}
-// Изменённый метод addClause
-void CNFNode::addClause(const CNFNode& newClause) {
-    CNFNode* current = this;
-    while (current->next != nullptr) {
-        current = current->next;
-    }
-    current->next = new CNFNode();
-    // Получаем размеры через const-корректные методы
-    size_t posSize = newClause.positiveVars.count_bytes() * 8; // Переводим байты в биты
-    size_t negSize = newClause.negativeVars.count_bytes() * 8;
-
-    // Создаём векторы нужного размера
-    current->next->positiveVars = BoolVector(posSize);
-    current->next->negativeVars = BoolVector(negSize);
-    for (size_t i = 0; i < newClause.positiveVars.count_bytes(); i++) {
-        current->next->positiveVars.vector[i] = newClause.positiveVars.vector[i];
-    }
-    for (size_t i = 0; i < newClause.negativeVars.count_bytes(); i++) {
-        current->next->negativeVars.vector[i] = newClause.negativeVars.vector[i];
-    }
-}
-
-// Изменённый метод resizeAll
-void CNFNode::resizeAll(size_t newSize) {
-    CNFNode* current = this;  // начинаем с текущей клаузы
-
-    while (current != nullptr) {  // пока не дошли до конца списка
-        current->positiveVars.resizeBytes(newSize);
-        current->negativeVars.resizeBytes(newSize);
-        current = current->next;   // переходим к следующей
-    }
-}
-
-
-void CNFNode::resize(size_t newSize) {
-    positiveVars.resize(newSize);
-    negativeVars.resize(newSize);
-
-}
-
-void CNFNode::copyFrom(const CNFNode& other) {
-    this->position = other.position;
-    this->positiveVars = other.positiveVars;
-    this->negativeVars = other.negativeVars;
-}
-
-void CNFNode::reset() {
-    position = -1;
-    positiveVars = BoolVector();
-    negativeVars = BoolVector();
-    // next остается nullptr
-}
@@ -0,0 +1,508 @@
+#include "BinaryTrace.h"
+
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <cstring>
+
+namespace {
+
+const char kMagic[4] = { 'C', 'N', 'F', 'T' };
+const uint16_t kVersion = 1;
+const int kHeaderSize = 8;         // Сигнатура + версия + флаги
+const int kMaxNesting = 4096;      // Защита от переполнения стека на поврежденных файлах
+
+// Флаги поля структуры
+enum FieldFlags : uint8_t {
+    FieldValid = 1 << 0,
+    FieldHasDirection = 1 << 1,
+    FieldHasOp = 1 << 2
+};
+
+// Флаги ветвления
+enum BranchFlags : uint8_t {
+    BranchTrue = 1 << 0,
+    BranchFalse = 1 << 1
+};
+
+void writeVarint(std::string& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+uint64_t zigzag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // namespace
+
+// ==================== BinaryTraceWriter ====================
+
+BinaryTraceWriter::BinaryTraceWriter()
+    : row_count_(0)
+{
+}
+
+void BinaryTraceWriter::addRow(const TraceStatement& row)
+{
+    writeStatement(row, true);
+    row_count_++;
+}
+
+bool BinaryTraceWriter::save(const std::string& file_path, std::string& error) const
+{
+    const std::string out = toBytes();
+    std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        error = "Failed to open file for writing: " + file_path;
+        return false;
+    }
+    if (!file.write(out.data(), static_cast<std::streamsize>(out.size())) || !file.flush()) {
+        error = "Failed to write file: " + file_path;
+        return false;
+    }
+    return true;
+}
+
+std::string BinaryTraceWriter::toBytes() const
+{
+    std::string out;
+    out.append(kMagic, sizeof(kMagic));
+    out.push_back(static_cast<char>(kVersion & 0xFF));
+    out.push_back(static_cast<char>(kVersion >> 8));
+    out.push_back('\0');
+    out.push_back('\0');
+    // Таблица строк (UTF-8)
+    writeVarint(out, static_cast<uint64_t>(strings_.size()));
+    for (const std::string& text : strings_) {
+        writeVarint(out, static_cast<uint64_t>(text.size()));
+        out.append(text);
+    }
+    // Строки трассы
+    writeVarint(out, static_cast<uint64_t>(row_count_));
+    out.append(rows_);
+    return out;
+}
+
+uint32_t BinaryTraceWriter::intern(const std::string& text)
+{
+    auto it = string_index_.find(text);
+    if (it != string_index_.end()) {
+        return it->second;
+    }
+    uint32_t index = static_cast<uint32_t>(strings_.size());
+    strings_.push_back(text);
+    string_index_.emplace(text, index);
+    return index;
+}
+
+void BinaryTraceWriter::writeStatement(const TraceStatement& statement, bool top_level)
+{
+    rows_.push_back(static_cast<char>(statement.kind));
+    if (top_level) {
+        writeVarint(rows_, zigzag(statement.id));
+    }
+    switch (statement.kind) {
+    case TraceStatement::Variable:
+        writeVarint(rows_, intern(statement.variable));
+        writeValue(statement.value);
+        if (statement.value.kind == TraceValue::Absent) {
+            rows_.push_back(static_cast<char>(statement.field ? 1 : 0));
+            if (statement.field) {
+                writeField(*statement.field);
+            }
+        }
+        break;
+    case TraceStatement::Operation:
+        rows_.push_back(static_cast<char>(statement.operation));
+        if (statement.operation == TraceStatement::Loop) {
+            rows_.push_back(static_cast<char>(statement.loop_valid ? 1 : 0));
+            if (statement.loop_valid) {
+                writeBody(statement.body);
+            }
+        } else if (statement.operation == TraceStatement::Branch) {
+            uint8_t flags = (statement.has_branch_true ? BranchTrue : 0)
+                           | (statement.has_branch_false ? BranchFalse : 0);
+            rows_.push_back(static_cast<char>(flags));
+            if (statement.has_branch_true) {
+                writeBody(statement.branch_true);
+            }
+            if (statement.has_branch_false) {
+                writeBody(statement.branch_false);
+            }
+        } else if (statement.operation == TraceStatement::Function || statement.operation == TraceStatement::Call) {
+            writeVarint(rows_, intern(statement.function));
+            writeVarint(rows_, static_cast<uint64_t>(statement.arguments.size()));
+            for (const std::string& argument : statement.arguments) {
+                writeVarint(rows_, intern(argument));
+            }
+            if (statement.operation == TraceStatement::Function) {
+                writeBody(statement.body);
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void BinaryTraceWriter::writeBody(const std::vector<TraceStatement>& body)
+{
+    writeVarint(rows_, static_cast<uint64_t>(body.size()));
+    for (const TraceStatement& statement : body) {
+        writeStatement(statement, false);
+    }
+}
+
+void BinaryTraceWriter::writeValue(const TraceValue& value)
+{
+    rows_.push_back(static_cast<char>(value.kind));
+    if (value.kind == TraceValue::Operation) {
+        rows_.push_back(static_cast<char>(value.op));
+        // Известные операции восстанавливаются по коду, строку храним только для прочих
+        if (value.op == TraceOp::Unknown) {
+            writeVarint(rows_, intern(value.text));
+        }
+    } else if (value.kind == TraceValue::Nested) {
+        writeVarint(rows_, intern(value.text));
+        rows_.push_back(static_cast<char>(value.field_kind));
+        if (value.field_kind == TraceValue::DirectedField) {
+            writeVarint(rows_, intern(value.field_direction));
+        }
+    }
+}
+
+void BinaryTraceWriter::writeField(const TraceField& field)
+{
+    uint8_t flags = (field.valid ? FieldValid : 0)
+                   | (field.has_direction ? FieldHasDirection : 0)
+                   | (field.op ? FieldHasOp : 0);
+    rows_.push_back(static_cast<char>(flags));
+    if (!field.valid) {
+        return;
+    }
+    if (field.has_direction) {
+        writeVarint(rows_, intern(field.direction));
+    }
+    if (field.op) {
+        writeField(*field.op);
+    }
+    writeValue(field.value);
+}
+
+// ==================== BinaryTraceReader ====================
+
+BinaryTraceReader::BinaryTraceReader()
+    : cursor_(nullptr), end_(nullptr), row_count_(0), rows_read_(0)
+{
+}
+
+bool BinaryTraceReader::isBinaryTrace(const std::string& file_path)
+{
+    std::ifstream file(file_path, std::ios::binary);
+    char header[sizeof(kMagic)];
+    return file.read(header, sizeof(header)) && memcmp(header, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool BinaryTraceReader::open(const std::string& file_path)
+{
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file) {
+        return fail("Failed to open file: " + file_path);
+    }
+    std::ostringstream data;
+    data << file.rdbuf();
+    return load(data.str());
+}
+
+bool BinaryTraceReader::load(std::string data)
+{
+    data_ = std::move(data);
+    error_.clear();
+    strings_.clear();
+    row_count_ = 0;
+    rows_read_ = 0;
+    cursor_ = reinterpret_cast<const unsigned char*>(data_.data());
+    end_ = cursor_ + data_.size();
+
+    if (data_.size() < static_cast<size_t>(kHeaderSize) || memcmp(cursor_, kMagic, sizeof(kMagic)) != 0) {
+        return fail("Not a binary trace");
+    }
+    uint16_t version = static_cast<uint16_t>(cursor_[4] | (cursor_[5] << 8));
+    if (version != kVersion) {
+        return fail("Unsupported binary trace version: " + std::to_string(version));
+    }
+    cursor_ += kHeaderSize;
+
+    uint64_t string_count = 0;
+    if (!readVarint(string_count) || string_count > static_cast<uint64_t>(end_ - cursor_)) {
+        return fail("Corrupted string table");
+    }
+    strings_.reserve(static_cast<size_t>(string_count));
+    for (uint64_t i = 0; i < string_count; ++i) {
+        uint64_t length = 0;
+        if (!readVarint(length) || length > static_cast<uint64_t>(end_ - cursor_)) {
+            return fail("Corrupted string table");
+        }
+        strings_.emplace_back(reinterpret_cast<const char*>(cursor_), static_cast<size_t>(length));
+        cursor_ += length;
+    }
+
+    uint64_t row_count = 0;
+    if (!readVarint(row_count)) {
+        return fail("Corrupted row count");
+    }
+    row_count_ = static_cast<int>(row_count);
+    return true;
+}
+
+bool BinaryTraceReader::next(TraceStatement& row)
+{
+    if (hasError() || rows_read_ >= row_count_) {
+        return false;
+    }
+    row = TraceStatement();
+    if (!readStatement(row, true, 0)) {
+        return false;
+    }
+    rows_read_++;
+    return true;
+}
+
+bool BinaryTraceReader::fail(const std::string& message)
+{
+    if (error_.empty()) {
+        error_ = message;
+    }
+    return false;
+}
+
+bool BinaryTraceReader::readByte(uint8_t& value)
+{
+    if (cursor_ >= end_) {
+        return fail("Unexpected end of binary trace");
+    }
+    value = *cursor_++;
+    return true;
+}
+
+bool BinaryTraceReader::readVarint(uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (cursor_ >= end_) {
+            return fail("Unexpected end of binary trace");
+        }
+        uint8_t byte = *cursor_++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return fail("Malformed varint");
+}
+
+bool BinaryTraceReader::readString(std::string& text)
+{
+    uint64_t index = 0;
+    if (!readVarint(index)) {
+        return false;
+    }
+    if (index >= static_cast<uint64_t>(strings_.size())) {
+        return fail("String index out of range");
+    }
+    text = strings_[static_cast<size_t>(index)];
+    return true;
+}
+
+bool BinaryTraceReader::readStatement(TraceStatement& statement, bool top_level, int depth)
+{
+    if (depth > kMaxNesting) {
+        return fail("Nesting too deep");
+    }
+    uint8_t kind = 0;
+    if (!readByte(kind)) {
+        return false;
+    }
+    if (kind > TraceStatement::Other) {
+        return fail("Unknown statement kind");
+    }
+    statement.kind = static_cast<TraceStatement::Kind>(kind);
+    if (top_level) {
+        uint64_t id = 0;
+        if (!readVarint(id)) {
+            return false;
+        }
+        statement.id = static_cast<int>(unzigzag(id));
+    }
+    switch (statement.kind) {
+    case TraceStatement::Variable: {
+        if (!readString(statement.variable) || !readValue(statement.value)) {
+            return false;
+        }
+        if (statement.value.kind == TraceValue::Absent) {
+            uint8_t has_field = 0;
+            if (!readByte(has_field)) {
+                return false;
+            }
+            if (has_field) {
+                statement.field = std::make_shared<TraceField>();
+                return readField(*statement.field, depth + 1);
+            }
+        }
+        return true;
+    }
+    case TraceStatement::Operation: {
+        uint8_t operation = 0;
+        if (!readByte(operation)) {
+            return false;
+        }
+        if (operation > TraceStatement::Call) {
+            return fail("Unknown operation kind");
+        }
+        statement.operation = static_cast<TraceStatement::OperationKind>(operation);
+        if (statement.operation == TraceStatement::Loop) {
+            uint8_t valid = 0;
+            if (!readByte(valid)) {
+                return false;
+            }
+            statement.loop_valid = valid != 0;
+            return !statement.loop_valid || readBody(statement.body, depth + 1);
+        }
+        if (statement.operation == TraceStatement::Branch) {
+            uint8_t flags = 0;
+            if (!readByte(flags)) {
+                return false;
+            }
+            statement.has_branch_true = (flags & BranchTrue) != 0;
+            statement.has_branch_false = (flags & BranchFalse) != 0;
+            if (statement.has_branch_true && !readBody(statement.branch_true, depth + 1)) {
+                return false;
+            }
+            if (statement.has_branch_false && !readBody(statement.branch_false, depth + 1)) {
+                return false;
+            }
+        }
+        if (statement.operation == TraceStatement::Function || statement.operation == TraceStatement::Call) {
+            uint64_t count = 0;
+            if (!readString(statement.function) || !readVarint(count)) {
+                return false;
+            }
+            if (count > static_cast<uint64_t>(end_ - cursor_)) {
+                return fail("Corrupted argument count");
+            }
+            statement.arguments.resize(static_cast<size_t>(count));
+            for (std::string& argument : statement.arguments) {
+                if (!readString(argument)) {
+                    return false;
+                }
+            }
+            return statement.operation != TraceStatement::Function || readBody(statement.body, depth + 1);
+        }
+        return true;
+    }
+    default:
+        return true;
+    }
+}
+
+bool BinaryTraceReader::readBody(std::vector<TraceStatement>& body, int depth)
+{
+    uint64_t count = 0;
+    if (!readVarint(count)) {
+        return false;
+    }
+    // Каждая инструкция занимает хотя бы байт
+    if (count > static_cast<uint64_t>(end_ - cursor_)) {
+        return fail("Corrupted body size");
+    }
+    body.reserve(static_cast<size_t>(count));
+    for (uint64_t i = 0; i < count; ++i) {
+        body.emplace_back();
+        if (!readStatement(body.back(), false, depth)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BinaryTraceReader::readValue(TraceValue& value)
+{
+    uint8_t kind = 0;
+    if (!readByte(kind)) {
+        return false;
+    }
+    if (kind > TraceValue::Other) {
+        return fail("Unknown value kind");
+    }
+    value.kind = static_cast<TraceValue::Kind>(kind);
+    if (value.kind == TraceValue::Operation) {
+        uint8_t op = 0;
+        if (!readByte(op)) {
+            return false;
+        }
+        if (op > static_cast<uint8_t>(TraceOp::DeleteArray)) {
+            return fail("Unknown memory operation code");
+        }
+        value.op = static_cast<TraceOp>(op);
+        if (value.op == TraceOp::Unknown) {
+            return readString(value.text);
+        }
+        value.text = traceOpName(value.op);
+    } else if (value.kind == TraceValue::Nested) {
+        uint8_t field_kind = 0;
+        if (!readString(value.text) || !readByte(field_kind)) {
+            return false;
+        }
+        if (field_kind > TraceValue::DirectedField) {
+            return fail("Unknown field kind");
+        }
+        value.field_kind = static_cast<TraceValue::FieldKind>(field_kind);
+        if (value.field_kind == TraceValue::DirectedField) {
+            if (!readString(value.field_direction)) {
+                return false;
+            }
+            value.field_dir = fieldDirectionFromString(value.field_direction);
+        }
+    }
+    return true;
+}
+
+bool BinaryTraceReader::readField(TraceField& field, int depth)
+{
+    if (depth > kMaxNesting) {
+        return fail("Nesting too deep");
+    }
+    uint8_t flags = 0;
+    if (!readByte(flags)) {
+        return false;
+    }
+    field.valid = (flags & FieldValid) != 0;
+    if (!field.valid) {
+        return true;
+    }
+    field.has_direction = (flags & FieldHasDirection) != 0;
+    if (field.has_direction) {
+        if (!readString(field.direction)) {
+            return false;
+        }
+        field.dir = fieldDirectionFromString(field.direction);
+    }
+    if (flags & FieldHasOp) {
+        field.op = std::make_shared<TraceField>();
+        if (!readField(*field.op, depth + 1)) {
+            return false;
+        }
+    }
+    return readValue(field.value);
+}
@@ -0,0 +1,78 @@
+#ifndef BINARYTRACE_H
+#define BINARYTRACE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "TraceRow.h"
+#include "TraceSource.h"
+
+// Компактный бинарный формат трассы.
+// Заголовок "CNFT" + версия, таблица интернированных строк (имена переменных,
+// направления полей, нераспознанные операции), затем строки трассы:
+// код вида и операции в одном байте, ссылки на строки и id - varint,
+// поля структур - цепочка флагов, тела ветвлений, циклов и функций - списки со счетчиком,
+// имя функции и аргументы - ссылки на строки.
+// Трасса конвертируется один раз при сборе и затем загружается без JSON.
+
+class BinaryTraceWriter
+{
+public:
+    BinaryTraceWriter();
+
+    void addRow(const TraceStatement& row);
+    int rowCount() const { return row_count_; }
+    bool save(const std::string& file_path, std::string& error) const;
+    // Закодированная трасса целиком (то же содержимое, что пишет save)
+    std::string toBytes() const;
+
+private:
+    std::string rows_;                      // Закодированные строки
+    int row_count_;
+    std::unordered_map<std::string, uint32_t> string_index_;  // Строка -> индекс в таблице
+    std::vector<std::string> strings_;
+
+    uint32_t intern(const std::string& text);
+    void writeStatement(const TraceStatement& statement, bool top_level);
+    void writeBody(const std::vector<TraceStatement>& body);
+    void writeValue(const TraceValue& value);
+    void writeField(const TraceField& field);
+};
+
+// Источник строк из бинарной трассы
+class BinaryTraceReader : public TraceSource
+{
+public:
+    BinaryTraceReader();
+
+    // Проверка сигнатуры формата без полной загрузки
+    static bool isBinaryTrace(const std::string& file_path);
+
+    bool open(const std::string& file_path);
+    bool load(std::string data);
+
+    int64_t rowCount() const override { return row_count_; }
+    // Декодировать следующую строку; false - конец трассы или ошибка
+    bool next(TraceStatement& row) override;
+
+private:
+    std::string data_;
+    const unsigned char* cursor_;
+    const unsigned char* end_;
+    std::vector<std::string> strings_;
+    int row_count_;
+    int rows_read_;
+
+    bool fail(const std::string& message);
+    bool readByte(uint8_t& value);
+    bool readVarint(uint64_t& value);
+    bool readString(std::string& text);
+    bool readStatement(TraceStatement& statement, bool top_level, int depth);
+    bool readBody(std::vector<TraceStatement>& body, int depth);
+    bool readValue(TraceValue& value);
+    bool readField(TraceField& field, int depth);
+};
+
+#endif // BINARYTRACE_H
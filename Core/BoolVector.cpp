@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <iostream>
+#include <algorithm>
 size_t BoolVector::calculateBytes(size_t bits){
     if (bits >= 1) {
     return ((bits - 1) / 8) + 1;
@@ -12,7 +13,10 @@ size_t BoolVector::calculateBytes(size_t bits){
 
 BoolVector::BoolVector() : vector(nullptr), bits(0), bytes(0) {}
 
-BoolVector::BoolVector(size_t input_bits) {
+BoolVector::BoolVector(size_t input_bits) : vector(nullptr), bits(0), bytes(0) {
+    if (input_bits == 0) {
+        return;
+    }
     bits = input_bits;
     bytes = ((bits - 1) / 8) + 1;
     vector = (unsigned char*)malloc(sizeof(unsigned char) * bytes);
@@ -23,6 +27,19 @@ BoolVector::BoolVector(size_t input_bits) {
     }
 }
 
+BoolVector::BoolVector(const BoolVector& other) : vector(nullptr), bits(other.bits), bytes(0) {
+    // Копируем только значащие байты, запас емкости не переносим
+    size_t used = calculateBytes(bits);
+    if (other.vector && used > 0) {
+        vector = (unsigned char*)malloc(sizeof(unsigned char) * used);
+        if (vector) {
+            memcpy(vector, other.vector, used);
+            bytes = used;
+        }
+    } else {
+        bits = 0;
+    }
+}
 
 BoolVector::~BoolVector() {
     if (vector) free(vector);
@@ -33,7 +50,7 @@ BoolVector& BoolVector::operator=(const BoolVector& other) {
         if (vector) free(vector);
         
         bits = other.bits;
-        bytes = other.bytes;
+        bytes = calculateBytes(bits);
         
         if (other.vector && bytes > 0) {
             vector = (unsigned char*)malloc(sizeof(unsigned char) * bytes);
@@ -42,6 +59,8 @@ BoolVector& BoolVector::operator=(const BoolVector& other) {
             }
         } else {
             vector = nullptr;
+            bits = 0;
+            bytes = 0;
         }
     }
     return *this;
@@ -57,7 +76,7 @@ size_t BoolVector::count_bytes() const{
 void BoolVector::print() const {
     if (vector)
     {
-        for (size_t i = 0; i < bytes; i++)
+        for (size_t i = 0; i < calculateBytes(bits); i++)
         {
             unsigned char mask = 1 << 7; // Создаем маску, начиная с самого левого бита
             // Цикл для обработки каждого бита в байте
@@ -110,52 +129,71 @@ bool BoolVector::isZero() const {
     return false;
 }
 
-void BoolVector::resizeBytes(size_t nbytes) {
-    if (vector)
-    {
-        size_t old_bytes = bytes;
-        size_t new_bytes = nbytes;
-        unsigned char *newVector = (unsigned char *)malloc(sizeof(unsigned char) * new_bytes); // выделение памяти под вектор
-        if (newVector)
-        {
-            for (size_t i = 0; i < new_bytes; i++)
-            { // Обнуление вектора
-                newVector[i] = 0;
-            }
-            for (size_t i = 0; i < old_bytes; i++)
-            { // Перенос значения на другой вектор
-                newVector[i] = vector[i];
+size_t BoolVector::findNextSetBit(size_t from) const {
+    if (!vector) {
+        return bits;
+    }
+    size_t bytePosition = from / 8;
+    if (bytePosition >= bytes) {
+        return bits;
+    }
+    // Первый байт маскируем, чтобы пропустить биты до from (старший бит первый)
+    unsigned char current = vector[bytePosition] & (0xFF >> (from % 8));
+    while (true) {
+        if (current != 0) {
+            size_t position = bytePosition * 8;
+            for (unsigned char mask = 1 << 7; (current & mask) == 0; mask >>= 1) {
+                position++;
             }
-
+            return position < bits ? position : bits;
+        }
+        // Нулевые байты пропускаем целиком
+        if (++bytePosition >= bytes) {
+            return bits;
         }
+        current = vector[bytePosition];
+    }
+}
+
+void BoolVector::reserveBytes(size_t nbytes) {
+    if (nbytes <= bytes) {
+        return;
+    }
+    unsigned char *newVector = (unsigned char *)realloc(vector, sizeof(unsigned char) * nbytes);
+    if (newVector)
+    {
+        // Обнуление добавленной части вектора
+        memset(newVector + bytes, 0, nbytes - bytes);
         vector = newVector;
-        bytes = new_bytes;
+        bytes = nbytes;
     }
 }
 
+void BoolVector::resizeBytes(size_t nbytes) {
+    reserveBytes(nbytes);
+}
+
 void BoolVector::resize(size_t new_size) {
-    if (this->bits == 0) {
-        this->vector = (unsigned char *)malloc(sizeof(unsigned char) * new_size);
+    // При уменьшении гасим отброшенные биты, чтобы они не всплыли при росте
+    for (size_t i = new_size; i < bits; i++) {
+        clearBit(i);
     }
-    if (vector)
-    {
-        size_t old_bytes = bytes;
-        size_t new_bytes = ((new_size - 1) / 8) + 1;
-        unsigned char *newVector = (unsigned char *)malloc(sizeof(unsigned char) * new_bytes); // выделение памяти под вектор
-        if (newVector)
-        {
-            for (size_t i = 0; i < new_bytes; i++)
-            { // Обнуление вектора
-                newVector[i] = 0;
-            }
-            for (size_t i = 0; i < old_bytes; i++)
-            { // Перенос значения на другой вектор
-                newVector[i] = vector[i];
-            }
+    reserveBytes(calculateBytes(new_size));
+    if (vector || new_size == 0) {
+        bits = new_size;
+    }
+}
 
-        }
-        vector = newVector;
-        bytes = new_bytes;
+void BoolVector::ensureSize(size_t new_size) {
+    if (new_size <= bits) {
+        return;
+    }
+    size_t required = calculateBytes(new_size);
+    if (required > bytes) {
+        // Удвоение емкости: расширение на один бит не копирует вектор каждый раз
+        reserveBytes(std::max(required, bytes * 2));
+    }
+    if (vector) {
         bits = new_size;
     }
 }
@@ -5,11 +5,12 @@
 #include <stdbool.h>
 
 class BoolVector {
-     friend class CNFNode;
 private:
     unsigned char* vector;
     size_t bits;
-    size_t bytes;
+    size_t bytes;   // Выделено байтов (не меньше calculateBytes(bits))
+
+    void reserveBytes(size_t nbytes);
 
 public:
     static size_t calculateBytes(size_t bits);
@@ -23,10 +24,14 @@ public:
     void setBit(size_t position);
     void clearBit(size_t position);
     bool isZero() const;
+    // Позиция первого установленного бита, начиная с from (size(), если такого нет)
+    size_t findNextSetBit(size_t from) const;
     size_t size() const;
     size_t count_bytes() const;
     void resize(size_t new_size);
      void resizeBytes(size_t new_size);
+    // Расширить вектор до new_size бит с геометрическим ростом памяти
+    void ensureSize(size_t new_size);
     bool getBit(size_t position) const {
         if (position >= bits) return false;
         size_t bytePos = position / 8;
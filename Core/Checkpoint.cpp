@@ -0,0 +1,473 @@
+#include "Checkpoint.h"
+
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+namespace {
+
+const uint32_t kSnapshotMagic = 0x434E4643;  // "CNFC"
+const uint32_t kJournalMagic = 0x434E464A;   // "CNFJ"
+const uint16_t kVersion = 5;                 // 2: строки UTF-8, порядок байтов little-endian
+                                             // 3: соединение хранит по одному литералу на сторону
+                                             // 4: узлы сводки по местам выделения
+                                             // 5: определения функций трассы
+const size_t kRecordHeaderBytes = 12;        // magic, длина, контрольная сумма
+
+uint32_t checksum(const char* data, size_t size)
+{
+    // FNV-1a: достаточно, чтобы отличить недописанную запись от целой
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Запись значений фиксированной ширины (little-endian) и строк с длиной
+class ByteWriter
+{
+public:
+    void u8(uint8_t value) { data_.push_back(static_cast<char>(value)); }
+    void u16(uint16_t value) { put(value, 2); }
+    void u32(uint32_t value) { put(value, 4); }
+    void i32(int32_t value) { put(static_cast<uint32_t>(value), 4); }
+    void i64(int64_t value) { put(static_cast<uint64_t>(value), 8); }
+    void boolean(bool value) { u8(value ? 1 : 0); }
+    void string(const std::string& text)
+    {
+        u32(static_cast<uint32_t>(text.size()));
+        data_.append(text);
+    }
+    const std::string& data() const { return data_; }
+
+private:
+    std::string data_;
+
+    void put(uint64_t value, int bytes)
+    {
+        for (int i = 0; i < bytes; ++i) {
+            data_.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+};
+
+// Чтение в том же формате; выход за границу данных переводит читателя в состояние ошибки
+class ByteReader
+{
+public:
+    ByteReader(const char* data, size_t size) : data_(data), size_(size), offset_(0), ok_(true) {}
+
+    bool ok() const { return ok_; }
+    uint8_t u8() { return static_cast<uint8_t>(get(1)); }
+    uint16_t u16() { return static_cast<uint16_t>(get(2)); }
+    uint32_t u32() { return static_cast<uint32_t>(get(4)); }
+    int32_t i32() { return static_cast<int32_t>(static_cast<uint32_t>(get(4))); }
+    int64_t i64() { return static_cast<int64_t>(get(8)); }
+    bool boolean() { return u8() != 0; }
+    std::string string()
+    {
+        uint32_t length = u32();
+        if (!ok_ || length > size_ - offset_) {
+            ok_ = false;
+            return std::string();
+        }
+        std::string text(data_ + offset_, length);
+        offset_ += length;
+        return text;
+    }
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t offset_;
+    bool ok_;
+
+    uint64_t get(int bytes)
+    {
+        if (!ok_ || static_cast<size_t>(bytes) > size_ - offset_) {
+            ok_ = false;
+            return 0;
+        }
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(data_[offset_ + i])) << (8 * i);
+        }
+        offset_ += bytes;
+        return value;
+    }
+};
+
+bool readFile(const std::string& path, std::string& data)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    data = buffer.str();
+    return true;
+}
+
+void writeState(ByteWriter& out, const CheckpointState& state)
+{
+    out.i64(state.rows_processed);
+    out.i64(state.source_size);
+    out.i32(state.memory_var_index);
+    out.boolean(state.has_memory_leak);
+    out.string(state.current_tree);
+    out.i32(state.position_high_water);
+    out.u32(static_cast<uint32_t>(state.free_positions.size()));
+    for (int position : state.free_positions) {
+        out.i32(position);
+    }
+    out.u32(static_cast<uint32_t>(state.summary_nodes.size()));
+    for (const CheckpointState::SummaryNode& node : state.summary_nodes) {
+        out.string(node.name);
+        out.i32(node.site);
+        out.i32(node.blocks);
+    }
+    out.string(state.functions);
+}
+
+bool readState(ByteReader& in, CheckpointState& state)
+{
+    state.rows_processed = in.i64();
+    state.source_size = in.i64();
+    state.memory_var_index = in.i32();
+    state.has_memory_leak = in.boolean();
+    state.current_tree = in.string();
+    state.position_high_water = in.i32();
+    uint32_t free_count = in.u32();
+    state.free_positions.clear();
+    for (uint32_t i = 0; i < free_count && in.ok(); ++i) {
+        state.free_positions.push_back(in.i32());
+    }
+    uint32_t summary_count = in.u32();
+    state.summary_nodes.clear();
+    for (uint32_t i = 0; i < summary_count && in.ok(); ++i) {
+        CheckpointState::SummaryNode node;
+        node.name = in.string();
+        node.site = in.i32();
+        node.blocks = in.i32();
+        state.summary_nodes.push_back(node);
+    }
+    state.functions = in.string();
+    return in.ok();
+}
+
+void writeTree(ByteWriter& out, const Tree& tree)
+{
+    out.string(tree.getName());
+    out.string(tree.getRoot() ? tree.getRoot().getName() : std::string());
+    out.u32(static_cast<uint32_t>(tree.getElementCount()));
+    for (const TreeElement& element : tree.getElements()) {
+        out.string(element.getName());
+        out.i32(element.getType());
+        out.i32(element.getPosition());
+    }
+    const std::vector<ConnectionRecord>& connections = tree.getConnectionRecords();
+    out.u32(static_cast<uint32_t>(connections.size()));
+    for (const ConnectionRecord& conn : connections) {
+        out.string(tree.elementName(conn.from));
+        out.string(tree.elementName(conn.to));
+        out.i32(conn.position);
+        out.i32(conn.positive);
+        out.i32(conn.negative);
+    }
+}
+
+Tree* readTree(ByteReader& in)
+{
+    std::string name = in.string();
+    std::string root_name = in.string();
+    uint32_t element_count = in.u32();
+    if (!in.ok() || name.empty()) {
+        return nullptr;
+    }
+    Tree* tree = new Tree(name);
+    for (uint32_t i = 0; i < element_count && in.ok(); ++i) {
+        std::string element_name = in.string();
+        int32_t type = in.i32();
+        int32_t position = in.i32();
+        tree->addElement(element_name, type, position);
+    }
+    // addElement делает корнем первый элемент, поэтому корень задается явно
+    tree->setRoot(tree->findElement(root_name));
+
+    uint32_t connection_count = in.u32();
+    for (uint32_t i = 0; i < connection_count && in.ok(); ++i) {
+        std::string from = in.string();
+        std::string to = in.string();
+        int32_t position = in.i32();
+        int32_t positive = in.i32();
+        int32_t negative = in.i32();
+        tree->addConnection(from, to, positive, negative, position);
+    }
+    if (!in.ok()) {
+        delete tree;
+        return nullptr;
+    }
+    return tree;
+}
+
+// Записать дерево менеджера: вытесненное дерево восстанавливается на время записи
+// и снова вытесняется, если память превышает бюджет (кроме текущего дерева анализатора)
+bool writeResidentTree(ByteWriter& out, const TreeManager& trees, const std::string& name,
+                       const std::string& current_tree, std::string& error)
+{
+    const Tree* tree = trees.getTree(name);
+    if (!tree) {
+        error = trees.errorString();
+        return false;
+    }
+    writeTree(out, *tree);
+    auto current = trees.getAllTrees().find(current_tree);
+    trees.trimToBudget(current != trees.getAllTrees().end() ? current->second : nullptr);
+    return true;
+}
+
+void installTree(TreeManager& trees, Tree* tree, PositionAllocator* allocator)
+{
+    tree->setPositionAllocator(allocator);
+    trees.removeTree(tree->getName());
+    trees.addTree(tree->getName(), tree);
+}
+
+} // namespace
+
+CheckpointStore::CheckpointStore(const std::string& path)
+    : path_(path),
+    journal_path_(path + ".journal"),
+    has_snapshot_(false),
+    deltas_since_snapshot_(0),
+    snapshot_every_(32),
+    snapshot_bytes_(0),
+    journal_bytes_(0),
+    last_was_snapshot_(false),
+    last_tree_count_(0)
+{
+}
+
+bool CheckpointStore::save(const CheckpointState& state, const TreeManager& trees)
+{
+    // Снимок, если журнал разросся до размера снимка или накопилось много дельт
+    if (!has_snapshot_ || deltas_since_snapshot_ >= snapshot_every_ || journal_bytes_ > snapshot_bytes_) {
+        return writeSnapshot(state, trees);
+    }
+    return appendDelta(state, trees);
+}
+
+bool CheckpointStore::writeSnapshot(const CheckpointState& state, const TreeManager& trees)
+{
+    ByteWriter out;
+    const std::map<std::string, Tree*>& all_trees = trees.getAllTrees();
+    out.u32(kSnapshotMagic);
+    out.u16(kVersion);
+    writeState(out, state);
+    out.u32(static_cast<uint32_t>(all_trees.size()));
+    for (const auto& entry : all_trees) {
+        if (!writeResidentTree(out, trees, entry.first, state.current_tree, error_)) {
+            return false;
+        }
+    }
+    last_tree_count_ = static_cast<int>(all_trees.size());
+    const std::string& data = out.data();
+
+    // Снимок пишется во временный файл и атомарно заменяет прежний
+    const std::string temp_path = path_ + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            error_ = "Failed to open checkpoint file: " + temp_path;
+            return false;
+        }
+        if (!file.write(data.data(), static_cast<std::streamsize>(data.size())) || !file.flush()) {
+            file.close();
+            std::remove(temp_path.c_str());
+            error_ = "Failed to write checkpoint file: " + path_;
+            return false;
+        }
+    }
+    // Старый журнал относится к старому снимку: удаляем его до замены снимка
+    std::remove(journal_path_.c_str());
+    if (std::rename(temp_path.c_str(), path_.c_str()) != 0) {
+        has_snapshot_ = false;
+        error_ = "Failed to commit checkpoint file: " + path_;
+        return false;
+    }
+
+    has_snapshot_ = true;
+    deltas_since_snapshot_ = 0;
+    snapshot_bytes_ = static_cast<int64_t>(data.size());
+    journal_bytes_ = 0;
+    last_was_snapshot_ = true;
+    rememberGenerations(trees);
+    return true;
+}
+
+bool CheckpointStore::appendDelta(const CheckpointState& state, const TreeManager& trees)
+{
+    const std::map<std::string, Tree*>& all_trees = trees.getAllTrees();
+    std::vector<std::string> changed;
+    for (const auto& entry : all_trees) {
+        const Tree* tree = entry.second;
+        auto it = written_.find(tree->getName());
+        if (it == written_.end() || it->second != tree->getGeneration()) {
+            changed.push_back(entry.first);
+        }
+    }
+    std::vector<std::string> removed;
+    for (const auto& entry : written_) {
+        if (all_trees.count(entry.first) == 0) {
+            removed.push_back(entry.first);
+        }
+    }
+
+    ByteWriter payload;
+    writeState(payload, state);
+    payload.u32(static_cast<uint32_t>(changed.size()));
+    for (const std::string& name : changed) {
+        if (!writeResidentTree(payload, trees, name, state.current_tree, error_)) {
+            return false;
+        }
+    }
+    payload.u32(static_cast<uint32_t>(removed.size()));
+    for (const std::string& name : removed) {
+        payload.string(name);
+    }
+
+    ByteWriter header;
+    header.u32(kJournalMagic);
+    header.u32(static_cast<uint32_t>(payload.data().size()));
+    header.u32(checksum(payload.data().data(), payload.data().size()));
+    const std::string record = header.data() + payload.data();
+
+    std::ofstream file(journal_path_, std::ios::binary | std::ios::app);
+    if (!file) {
+        error_ = "Failed to open checkpoint journal: " + journal_path_;
+        return false;
+    }
+    if (!file.write(record.data(), static_cast<std::streamsize>(record.size())) || !file.flush()) {
+        error_ = "Failed to write checkpoint journal: " + journal_path_;
+        // Недописанная запись будет отброшена при загрузке; следующая запись — снимок
+        has_snapshot_ = false;
+        return false;
+    }
+    file.close();
+
+    deltas_since_snapshot_++;
+    journal_bytes_ += static_cast<int64_t>(record.size());
+    last_was_snapshot_ = false;
+    last_tree_count_ = static_cast<int>(changed.size());
+    for (const std::string& name : changed) {
+        written_[name] = all_trees.at(name)->getGeneration();
+    }
+    for (const std::string& name : removed) {
+        written_.erase(name);
+    }
+    return true;
+}
+
+bool CheckpointStore::load(CheckpointState& state, TreeManager& trees, PositionAllocator* allocator)
+{
+    std::string data;
+    if (!readFile(path_, data)) {
+        error_ = "Failed to open checkpoint file: " + path_;
+        return false;
+    }
+
+    ByteReader in(data.data(), data.size());
+    uint32_t magic = in.u32();
+    uint16_t version = in.u16();
+    if (magic != kSnapshotMagic || version != kVersion) {
+        error_ = "Not a checkpoint file: " + path_;
+        return false;
+    }
+    if (!readState(in, state)) {
+        error_ = "Corrupted checkpoint state";
+        return false;
+    }
+
+    trees.clear();
+    uint32_t tree_count = in.u32();
+    for (uint32_t i = 0; i < tree_count; ++i) {
+        Tree* tree = readTree(in);
+        if (!tree) {
+            trees.clear();
+            error_ = "Corrupted checkpoint tree data";
+            return false;
+        }
+        installTree(trees, tree, allocator);
+    }
+
+    std::string journal_data;
+    if (readFile(journal_path_, journal_data)) {
+        if (!applyJournal(journal_data, state, trees, allocator)) {
+            trees.clear();
+            return false;
+        }
+    }
+
+    if (allocator) {
+        allocator->restore(state.position_high_water, state.free_positions);
+    }
+    return true;
+}
+
+bool CheckpointStore::applyJournal(const std::string& journal, CheckpointState& state,
+                                   TreeManager& trees, PositionAllocator* allocator)
+{
+    size_t offset = 0;
+    while (journal.size() - offset >= kRecordHeaderBytes) {
+        ByteReader header(journal.data() + offset, kRecordHeaderBytes);
+        uint32_t magic = header.u32();
+        uint32_t length = header.u32();
+        uint32_t sum = header.u32();
+        // Обрыв или порча: дальнейшие записи не применяются
+        if (magic != kJournalMagic || length > journal.size() - offset - kRecordHeaderBytes) {
+            break;
+        }
+        const char* payload = journal.data() + offset + kRecordHeaderBytes;
+        if (checksum(payload, length) != sum) {
+            break;
+        }
+        offset += kRecordHeaderBytes + length;
+
+        ByteReader in(payload, length);
+        CheckpointState record_state;
+        if (!readState(in, record_state)) {
+            error_ = "Corrupted checkpoint journal";
+            return false;
+        }
+        uint32_t changed_count = in.u32();
+        for (uint32_t i = 0; i < changed_count; ++i) {
+            Tree* tree = readTree(in);
+            if (!tree) {
+                error_ = "Corrupted checkpoint journal";
+                return false;
+            }
+            installTree(trees, tree, allocator);
+        }
+        uint32_t removed_count = in.u32();
+        for (uint32_t i = 0; i < removed_count && in.ok(); ++i) {
+            trees.removeTree(in.string());
+        }
+        if (!in.ok()) {
+            error_ = "Corrupted checkpoint journal";
+            return false;
+        }
+        state = record_state;
+    }
+    return true;
+}
+
+void CheckpointStore::rememberGenerations(const TreeManager& trees)
+{
+    written_.clear();
+    for (const auto& entry : trees.getAllTrees()) {
+        written_[entry.first] = entry.second->getGeneration();
+    }
+}
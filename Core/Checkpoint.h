@@ -0,0 +1,76 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "TreeManager.h"
+#include "PositionAllocator.h"
+
+// Состояние анализатора помимо самих деревьев
+struct CheckpointState
+{
+    int64_t rows_processed = 0;     // Сколько строк трассы уже обработано
+    int64_t source_size = -1;       // Размер файла трассы (сверяется при возобновлении)
+    int memory_var_index = 0;
+    bool has_memory_leak = false;
+    std::string current_tree;       // Имя текущего дерева (пусто, если его нет)
+    int position_high_water = 0;
+    std::vector<int> free_positions;
+
+    // Узлы сводки по местам выделения (в порядке создания внутри места)
+    struct SummaryNode {
+        std::string name;
+        int site;
+        int blocks;
+    };
+    std::vector<SummaryNode> summary_nodes;
+    std::string functions;          // Определения функций трассы в бинарном формате трассы
+};
+
+// Контрольные точки анализа: полный снимок в <path> и журнал изменений в <path>.journal.
+// Первая запись в сессии и каждая snapshotEvery()-я после нее — полный снимок,
+// остальные дописывают в журнал только деревья, изменившиеся с прошлой записи
+// (по Tree::getGeneration), и имена удаленных деревьев. Журнал удаляется до замены
+// снимка, поэтому на диске всегда согласованная пара; недописанный хвост журнала
+// при загрузке отбрасывается.
+class CheckpointStore
+{
+public:
+    explicit CheckpointStore(const std::string& path);
+
+    void setSnapshotEvery(int deltas) { snapshot_every_ = deltas < 1 ? 1 : deltas; }
+    int snapshotEvery() const { return snapshot_every_; }
+
+    // Записать контрольную точку (снимок или дельту)
+    bool save(const CheckpointState& state, const TreeManager& trees);
+    // Восстановить состояние: снимок плюс все целые записи журнала
+    bool load(CheckpointState& state, TreeManager& trees, PositionAllocator* allocator);
+
+    bool lastWasSnapshot() const { return last_was_snapshot_; }
+    int lastTreeCount() const { return last_tree_count_; }
+    const std::string& errorString() const { return error_; }
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+    std::string journal_path_;
+    bool has_snapshot_;                 // В этой сессии уже записан снимок
+    int deltas_since_snapshot_;
+    int snapshot_every_;
+    int64_t snapshot_bytes_;
+    int64_t journal_bytes_;
+    std::unordered_map<std::string, uint64_t> written_;  // Имя дерева -> поколение на момент последней записи
+    bool last_was_snapshot_;
+    int last_tree_count_;               // Сколько деревьев попало в последнюю запись
+    std::string error_;
+
+    bool writeSnapshot(const CheckpointState& state, const TreeManager& trees);
+    bool appendDelta(const CheckpointState& state, const TreeManager& trees);
+    bool applyJournal(const std::string& journal, CheckpointState& state,
+                      TreeManager& trees, PositionAllocator* allocator);
+    void rememberGenerations(const TreeManager& trees);
+};
+
+#endif // CHECKPOINT_H
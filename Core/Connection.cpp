@@ -0,0 +1,35 @@
+#include "Connection.h"
+#include "Tree.h"
+#include <sstream>
+
+const std::string& Connection::getFrom() const
+{
+    return tree_->elementName(record_.from);
+}
+
+const std::string& Connection::getTo() const
+{
+    return tree_->elementName(record_.to);
+}
+
+bool Connection::isValid() const
+{
+    // Соединение считается валидным, если:
+    // 1. Оба конца — существующие элементы дерева
+    // 2. Концы разные
+    return tree_ &&
+           tree_->isElementId(record_.from) &&
+           tree_->isElementId(record_.to) &&
+           record_.from != record_.to;
+}
+
+std::string Connection::toString() const
+{
+    std::ostringstream result;
+    result << "Connection[from: '" << (tree_ ? getFrom() : std::string()) << "', to: '"
+           << (tree_ ? getTo() : std::string())
+           << "', positive: " << record_.positive
+           << ", negative: " << record_.negative
+           << ", position: " << record_.position << "]";
+    return result.str();
+}
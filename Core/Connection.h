@@ -0,0 +1,52 @@
+#ifndef CONNECTION_H
+#define CONNECTION_H
+
+#include <string>
+#include <cstdint>
+#include "TreeElement.h"
+
+class Tree;
+
+// Запись соединения в плоском массиве дерева. Концы — идентификаторы элементов
+// дерева; литералы — позиции переменных клаузы (-1, если литерала нет)
+struct ConnectionRecord
+{
+    uint32_t from;
+    uint32_t to;
+    int32_t positive;   // Позиция приемника (положительный литерал)
+    int32_t negative;   // Позиция источника (отрицательный литерал)
+    int32_t position;   // Позиция (id из парсинга)
+};
+
+// Представление соединения дерева: копия записи и указатель на дерево для имен концов.
+// Имена читаются из дерева, поэтому представление действительно, пока дерево живо и
+// в него не добавлен новый элемент (идентификаторы удаленных элементов переиспользуются)
+class Connection
+{
+public:
+    Connection() : tree_(nullptr), record_{0, 0, -1, -1, -1} {}
+    Connection(const Tree* tree, const ConnectionRecord& record) : tree_(tree), record_(record) {}
+
+    // Соединение найдено (пустое представление возвращается при неудачном поиске)
+    explicit operator bool() const { return tree_ != nullptr; }
+
+    // Геттеры
+    const std::string& getFrom() const;
+    const std::string& getTo() const;
+    TreeElement getFromElement() const { return TreeElement(tree_, record_.from); }
+    TreeElement getToElement() const { return TreeElement(tree_, record_.to); }
+    int getPositiveLiteral() const { return record_.positive; }
+    int getNegativeLiteral() const { return record_.negative; }
+    int getPosition() const { return record_.position; }
+    const ConnectionRecord& getRecord() const { return record_; }
+
+    // Вспомогательные методы
+    bool isValid() const;
+    std::string toString() const;
+
+private:
+    const Tree* tree_;
+    ConnectionRecord record_;
+};
+
+#endif // CONNECTION_H
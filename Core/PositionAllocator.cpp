@@ -0,0 +1,55 @@
+#include "PositionAllocator.h"
+
+PositionAllocator::PositionAllocator()
+    : next_(0)
+{
+}
+
+int PositionAllocator::acquire()
+{
+    if (!free_.empty()) {
+        int position = *free_.begin();
+        free_.erase(free_.begin());
+        return position;
+    }
+    return next_++;
+}
+
+void PositionAllocator::release(int position)
+{
+    // Игнорируем чужие и повторно освобождаемые позиции
+    if (position < 0 || position >= next_) {
+        return;
+    }
+    if (!free_.insert(position).second) {
+        return;
+    }
+
+    // Свободный хвост сразу отдаем обратно, опуская границу
+    while (!free_.empty() && *free_.rbegin() == next_ - 1) {
+        free_.erase(std::prev(free_.end()));
+        next_--;
+    }
+}
+
+void PositionAllocator::reset(int live_count)
+{
+    free_.clear();
+    next_ = live_count;
+}
+
+void PositionAllocator::clear()
+{
+    reset(0);
+}
+
+void PositionAllocator::restore(int high_water, const std::vector<int>& free_positions)
+{
+    next_ = high_water < 0 ? 0 : high_water;
+    free_.clear();
+    for (int position : free_positions) {
+        if (position >= 0 && position < next_) {
+            free_.insert(position);
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef POSITIONALLOCATOR_H
+#define POSITIONALLOCATOR_H
+
+#include <set>
+#include <vector>
+#include <iterator>
+
+// Распределитель позиций переменных (номеров битов в векторах соединений).
+// Освобожденные позиции попадают в список свободных и выдаются повторно,
+// начиная с наименьшей, поэтому ширина векторов следует за живой кучей,
+// а не за длиной трассы.
+class PositionAllocator
+{
+public:
+    PositionAllocator();
+
+    // Выдать свободную позицию (наименьшую из освобожденных или новую)
+    int acquire();
+    // Вернуть позицию в список свободных
+    void release(int position);
+
+    // Граница выделенных позиций: все занятые позиции меньше неё
+    int highWater() const { return next_; }
+    int freeCount() const { return static_cast<int>(free_.size()); }
+    int liveCount() const { return next_ - freeCount(); }
+
+    // Сброс после уплотнения: позиции [0, live_count) заняты, свободных нет
+    void reset(int live_count);
+    void clear();
+
+    // Состояние для контрольных точек: граница и освобожденные позиции
+    std::vector<int> freePositions() const { return std::vector<int>(free_.begin(), free_.end()); }
+    void restore(int high_water, const std::vector<int>& free_positions);
+
+private:
+    std::set<int> free_;  // Освобожденные позиции ниже границы
+    int next_;            // Следующая новая позиция
+};
+
+#endif // POSITIONALLOCATOR_H
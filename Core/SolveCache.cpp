@@ -0,0 +1,82 @@
+#include "SolveCache.h"
+
+SolveCache::SolveCache(size_t capacity)
+    : capacity_(capacity > 0 ? capacity : 1),
+    hits_(0),
+    misses_(0)
+{
+}
+
+std::string SolveCache::makeKey(const CnfFormula& formula)
+{
+    // Литералы подряд по 4 байта, клаузы разделены нулем (литерала 0 не бывает)
+    std::string key;
+    key.reserve((formula.clauses.literalCount() + formula.clauses.size()) * 4 + 4);
+    auto append = [&key](int32_t value) {
+        key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    append(formula.num_vars);
+    for (ClauseDatabase::Clause clause : formula.clauses) {
+        for (int literal : clause) {
+            append(literal);
+        }
+        append(0);
+    }
+    return key;
+}
+
+bool SolveCache::lookup(const CnfFormula& formula, SolveResult& result)
+{
+    std::string key = makeKey(formula);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        ++misses_;
+        return false;
+    }
+    ++hits_;
+    result = it->second ? SolveResult::Sat : SolveResult::Unsat;
+    return true;
+}
+
+void SolveCache::store(const CnfFormula& formula, SolveResult result)
+{
+    if (result == SolveResult::Unknown) {
+        return;
+    }
+    std::string key = makeKey(formula);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!entries_.emplace(key, result == SolveResult::Sat).second) {
+        return;
+    }
+    order_.push_back(std::move(key));
+    while (order_.size() > capacity_) {
+        entries_.erase(order_.front());
+        order_.pop_front();
+    }
+}
+
+void SolveCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    order_.clear();
+}
+
+size_t SolveCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+uint64_t SolveCache::hits() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+uint64_t SolveCache::misses() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
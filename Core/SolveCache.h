@@ -0,0 +1,40 @@
+#ifndef SOLVECACHE_H
+#define SOLVECACHE_H
+
+#include <string>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+#include "CNF/CnfFormula.h"
+#include "CNF/SolverBackend.h"
+
+// Кэш вердиктов формул, общий для нескольких анализаторов (потокобезопасный).
+// Ключ — формула в локальной нумерации DIMACS, поэтому одинаковые по форме деревья
+// разных трасс решаются один раз. Хранится только Sat/Unsat, без модели.
+// При переполнении вытесняются самые старые записи.
+class SolveCache
+{
+public:
+    explicit SolveCache(size_t capacity = 65536);
+
+    bool lookup(const CnfFormula& formula, SolveResult& result);
+    void store(const CnfFormula& formula, SolveResult result);
+    void clear();
+
+    size_t size() const;
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+private:
+    static std::string makeKey(const CnfFormula& formula);
+
+    mutable std::mutex mutex_;
+    size_t capacity_;
+    std::unordered_map<std::string, bool> entries_;  // Ключ формулы -> SAT
+    std::deque<std::string> order_;                  // Порядок добавления для вытеснения
+    uint64_t hits_;
+    uint64_t misses_;
+};
+
+#endif // SOLVECACHE_H
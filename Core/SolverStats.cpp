@@ -0,0 +1,261 @@
+#include "SolverStats.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+// Верхние границы групп размера дерева; последняя группа не ограничена
+const size_t kSizeBounds[] = {8, 32, 128, 512, 2048, 8192};
+
+// Секунды с точностью до наносекунды, без экспоненты у малых значений
+std::string formatSeconds(double value)
+{
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(9) << value;
+    return text.str();
+}
+
+} // namespace
+
+SolverStats::SolverStats()
+{
+    clear();
+}
+
+void SolverStats::clear()
+{
+    total_ = Counters();
+    for (Counters& counters : by_size_) {
+        counters = Counters();
+    }
+    for (int64_t& count : skipped_) {
+        count = 0;
+    }
+    rows_ = 0;
+    in_row_ = false;
+    row_solves_ = 0;
+    row_solves_max_ = 0;
+    row_solves_sum_ = 0;
+    for (int64_t& count : row_histogram_) {
+        count = 0;
+    }
+}
+
+void SolverStats::beginRow()
+{
+    in_row_ = true;
+    row_solves_ = 0;
+}
+
+void SolverStats::endRow()
+{
+    if (!in_row_) {
+        return;
+    }
+    in_row_ = false;
+    rows_++;
+    row_solves_sum_ += row_solves_;
+    row_solves_max_ = std::max(row_solves_max_, row_solves_);
+    int bucket = 0;
+    while (bucket < kRowBuckets - 1 && row_solves_ > rowBound(bucket)) {
+        bucket++;
+    }
+    row_histogram_[bucket]++;
+}
+
+void SolverStats::addSolve(size_t connections, const CnfFormula& formula, const SolveStats& stats,
+                           double seconds, SolveResult result)
+{
+    if (in_row_) {
+        row_solves_++;
+    }
+    for (Counters* counters : {&total_, &by_size_[sizeBucket(connections)]}) {
+        counters->solves++;
+        counters->sat += result == SolveResult::Sat ? 1 : 0;
+        counters->unsat += result == SolveResult::Unsat ? 1 : 0;
+        counters->unknown += result == SolveResult::Unknown ? 1 : 0;
+        counters->variables += formula.num_vars;
+        counters->clauses += static_cast<int64_t>(formula.clauses.size());
+        counters->decisions += stats.decisions;
+        counters->conflicts += stats.conflicts;
+        counters->propagations += stats.propagations;
+        counters->seconds += seconds;
+    }
+}
+
+int64_t SolverStats::skipCount() const
+{
+    int64_t count = 0;
+    for (int64_t skipped : skipped_) {
+        count += skipped;
+    }
+    return count;
+}
+
+int SolverStats::sizeBucket(size_t connections)
+{
+    int bucket = 0;
+    while (bucket < kSizeBuckets - 1 && connections > kSizeBounds[bucket]) {
+        bucket++;
+    }
+    return bucket;
+}
+
+std::string SolverStats::sizeLabel(int bucket)
+{
+    if (bucket == kSizeBuckets - 1) {
+        return std::to_string(kSizeBounds[bucket - 1] + 1) + "+";
+    }
+    const size_t low = bucket == 0 ? 1 : kSizeBounds[bucket - 1] + 1;
+    return std::to_string(low) + "-" + std::to_string(kSizeBounds[bucket]);
+}
+
+int64_t SolverStats::rowBound(int bucket)
+{
+    // 0, 1, 2, 4, ..., 64; у последней группы границы нет
+    if (bucket == kRowBuckets - 1) {
+        return -1;
+    }
+    return bucket == 0 ? 0 : int64_t(1) << (bucket - 1);
+}
+
+const char* SolverStats::skipName(int reason)
+{
+    switch (reason) {
+    case EmptyTree: return "empty_tree";
+    case NoConnections: return "no_connections";
+    case NoVariables: return "no_variables";
+    case CacheHit: return "cache_hit";
+    case UnchangedTree: return "unchanged_tree";
+    default: return "unknown";
+    }
+}
+
+void SolverStats::writeCountersJson(std::ostream& out, const Counters& counters)
+{
+    out << "\"solves\": " << counters.solves
+        << ", \"sat\": " << counters.sat
+        << ", \"unsat\": " << counters.unsat
+        << ", \"unknown\": " << counters.unknown
+        << ", \"variables\": " << counters.variables
+        << ", \"clauses\": " << counters.clauses
+        << ", \"decisions\": " << counters.decisions
+        << ", \"conflicts\": " << counters.conflicts
+        << ", \"propagations\": " << counters.propagations
+        << ", \"seconds\": " << formatSeconds(counters.seconds);
+}
+
+void SolverStats::writeJson(std::ostream& out) const
+{
+    out << "{\n  \"rows\": " << rows_ << ",\n  \"total\": {";
+    writeCountersJson(out, total_);
+    out << "},\n  \"skipped\": {";
+    for (int reason = 0; reason < SkipReasonCount; ++reason) {
+        out << (reason ? ", " : "") << "\"" << skipName(reason) << "\": " << skipped_[reason];
+    }
+    out << "},\n  \"by_tree_size\": [";
+    for (int bucket = 0; bucket < kSizeBuckets; ++bucket) {
+        out << (bucket ? "," : "") << "\n    {\"connections\": \"" << sizeLabel(bucket) << "\", ";
+        writeCountersJson(out, by_size_[bucket]);
+        out << "}";
+    }
+    out << "\n  ],\n  \"solves_per_row\": {\"max\": " << row_solves_max_ << ", \"sum\": " << row_solves_sum_
+        << ", \"buckets\": [";
+    for (int bucket = 0; bucket < kRowBuckets; ++bucket) {
+        out << (bucket ? ", " : "") << "{\"le\": ";
+        if (rowBound(bucket) < 0) {
+            out << "null";
+        } else {
+            out << rowBound(bucket);
+        }
+        out << ", \"rows\": " << row_histogram_[bucket] << "}";
+    }
+    out << "]}\n}\n";
+}
+
+void SolverStats::writePrometheus(std::ostream& out) const
+{
+    const std::string prefix = "treeprogram_";
+    auto header = [&](const std::string& name, const char* type, const char* help) {
+        out << "# HELP " << prefix << name << " " << help << "\n"
+            << "# TYPE " << prefix << name << " " << type << "\n";
+    };
+    // Счетчик по группам размера дерева
+    auto bySize = [&](const std::string& name, const char* help, int64_t Counters::*field) {
+        header(name, "counter", help);
+        for (int bucket = 0; bucket < kSizeBuckets; ++bucket) {
+            out << prefix << name << "{tree_size=\"" << sizeLabel(bucket) << "\"} "
+                << by_size_[bucket].*field << "\n";
+        }
+    };
+
+    header("rows_total", "counter", "Trace rows analysed.");
+    out << prefix << "rows_total " << rows_ << "\n";
+
+    header("solves_total", "counter", "Solver calls by tree size and result.");
+    for (int bucket = 0; bucket < kSizeBuckets; ++bucket) {
+        const Counters& counters = by_size_[bucket];
+        const std::pair<const char*, int64_t> results[] = {
+            {"sat", counters.sat}, {"unsat", counters.unsat}, {"unknown", counters.unknown}};
+        for (const auto& result : results) {
+            out << prefix << "solves_total{tree_size=\"" << sizeLabel(bucket) << "\",result=\""
+                << result.first << "\"} " << result.second << "\n";
+        }
+    }
+
+    header("solves_skipped_total", "counter", "Verdicts obtained without calling the solver, by reason.");
+    for (int reason = 0; reason < SkipReasonCount; ++reason) {
+        out << prefix << "solves_skipped_total{reason=\"" << skipName(reason) << "\"} " << skipped_[reason] << "\n";
+    }
+
+    bySize("solve_variables_total", "CNF variables passed to the solver.", &Counters::variables);
+    bySize("solve_clauses_total", "CNF clauses passed to the solver.", &Counters::clauses);
+    bySize("solver_decisions_total", "Solver decisions.", &Counters::decisions);
+    bySize("solver_conflicts_total", "Solver conflicts.", &Counters::conflicts);
+    bySize("solver_propagations_total", "Solver propagations.", &Counters::propagations);
+
+    header("solve_seconds_total", "counter", "Wall time spent in the solver.");
+    for (int bucket = 0; bucket < kSizeBuckets; ++bucket) {
+        out << prefix << "solve_seconds_total{tree_size=\"" << sizeLabel(bucket) << "\"} "
+            << formatSeconds(by_size_[bucket].seconds) << "\n";
+    }
+
+    header("row_solves", "histogram", "Solver calls per trace row.");
+    int64_t cumulative = 0;
+    for (int bucket = 0; bucket < kRowBuckets; ++bucket) {
+        cumulative += row_histogram_[bucket];
+        out << prefix << "row_solves_bucket{le=\""
+            << (rowBound(bucket) < 0 ? std::string("+Inf") : std::to_string(rowBound(bucket)))
+            << "\"} " << cumulative << "\n";
+    }
+    out << prefix << "row_solves_sum " << row_solves_sum_ << "\n"
+        << prefix << "row_solves_count " << rows_ << "\n";
+}
+
+bool SolverStats::writeFile(const std::string& path, Format format, std::string& error) const
+{
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (format == Prometheus) {
+            writePrometheus(file);
+        } else {
+            writeJson(file);
+        }
+        file.flush();
+        if (!file) {
+            error = "Failed to write statistics file: " + temp_path;
+            std::remove(temp_path.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        error = "Failed to rename statistics file to: " + path;
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
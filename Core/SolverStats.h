@@ -0,0 +1,87 @@
+#ifndef SOLVERSTATS_H
+#define SOLVERSTATS_H
+
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include "CNF/CnfFormula.h"
+#include "CNF/SolverBackend.h"
+
+// Статистика решений за прогон анализатора: счетчики вызовов решателя и их
+// поиска по группам размера дерева (числу соединений), причины решений без
+// вызова решателя и распределение числа вызовов на строку трассы.
+// Выгружается в JSON и в текстовый формат Prometheus
+class SolverStats
+{
+public:
+    // Вердикт получен без вызова решателя
+    enum SkipReason {
+        EmptyTree = 0,      // Все элементы освобождены
+        NoConnections,      // Элементы без соединений: утечка без решения
+        NoVariables,        // Соединения не дают переменных
+        CacheHit,           // Вердикт из общего кэша формул
+        UnchangedTree,      // Дерево не менялось после прошлого решения (отчет об изменениях)
+        SkipReasonCount
+    };
+    enum Format {
+        Json = 0,
+        Prometheus
+    };
+
+    SolverStats();
+
+    // Границы строки трассы: вызовы решателя между ними считаются вызовами строки.
+    // Решения финального анализа в распределение по строкам не входят
+    void beginRow();
+    void endRow();
+    // Вызов решателя: размер дерева, формула, счетчики поиска, время и ответ
+    void addSolve(size_t connections, const CnfFormula& formula, const SolveStats& stats,
+                  double seconds, SolveResult result);
+    void addSkip(SkipReason reason) { skipped_[reason]++; }
+    void clear();
+
+    int64_t rowCount() const { return rows_; }
+    int64_t solveCount() const { return total_.solves; }
+    int64_t skipCount() const;
+
+    void writeJson(std::ostream& out) const;
+    void writePrometheus(std::ostream& out) const;
+    // Запись во временный файл и переименование: читатель не увидит файл наполовину
+    bool writeFile(const std::string& path, Format format, std::string& error) const;
+
+private:
+    struct Counters {
+        int64_t solves = 0;
+        int64_t sat = 0;
+        int64_t unsat = 0;
+        int64_t unknown = 0;        // Лимит, прерывание или ошибка решателя
+        int64_t variables = 0;
+        int64_t clauses = 0;
+        int64_t decisions = 0;
+        int64_t conflicts = 0;
+        int64_t propagations = 0;
+        double seconds = 0;
+    };
+    // Группы размера дерева: до 8, 32, 128, 512, 2048, 8192 соединений и больше
+    static const int kSizeBuckets = 7;
+    // Группы числа вызовов на строку: 0, 1, 2, 4, ..., 64 и больше
+    static const int kRowBuckets = 9;
+
+    static int sizeBucket(size_t connections);
+    static std::string sizeLabel(int bucket);
+    static int64_t rowBound(int bucket);
+    static const char* skipName(int reason);
+    static void writeCountersJson(std::ostream& out, const Counters& counters);
+
+    Counters total_;
+    Counters by_size_[kSizeBuckets];
+    int64_t skipped_[SkipReasonCount];
+    int64_t rows_;
+    bool in_row_;
+    int64_t row_solves_;                    // Вызовы в текущей строке
+    int64_t row_solves_max_;
+    int64_t row_solves_sum_;
+    int64_t row_histogram_[kRowBuckets];    // Строки по группам (не накопительно)
+};
+
+#endif // SOLVERSTATS_H
@@ -0,0 +1,111 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstddef>
+
+// Ограниченная очередь без блокировок для одного производителя и одного потребителя.
+// Индексы растут монотонно, позиция в буфере — индекс по маске (емкость — степень двойки).
+// Заполненная очередь задерживает производителя (обратное давление), пустая — потребителя.
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity)
+        : head_(0), tail_(0), closed_(false), cancelled_(false)
+    {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    size_t capacity() const { return slots_.size(); }
+
+    // Производитель: добавить элемент, если есть место
+    bool tryPush(T&& item)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == slots_.size()) {
+            return false;
+        }
+        slots_[tail & mask_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Потребитель: забрать элемент, если он есть
+    bool tryPop(T& item)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(slots_[head & mask_]);
+        slots_[head & mask_] = T(); // Освобождаем память элемента сразу
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Ждать места; false, если потребитель отказался от элементов (cancel)
+    bool push(T&& item)
+    {
+        unsigned spins = 0;
+        while (!tryPush(std::move(item))) {
+            if (cancelled_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            backoff(spins);
+        }
+        return true;
+    }
+
+    // Ждать элемента; false, если очередь закрыта и пуста
+    bool pop(T& item)
+    {
+        unsigned spins = 0;
+        while (!tryPop(item)) {
+            if (closed_.load(std::memory_order_acquire)) {
+                // Элементы, добавленные до close, уже видны
+                return tryPop(item);
+            }
+            backoff(spins);
+        }
+        return true;
+    }
+
+    // Производитель: элементов больше не будет
+    void close() { closed_.store(true, std::memory_order_release); }
+    // Потребитель: оставшиеся элементы не нужны, производитель может завершаться
+    void cancel() { cancelled_.store(true, std::memory_order_release); }
+    bool isCancelled() const { return cancelled_.load(std::memory_order_acquire); }
+
+private:
+    std::vector<T> slots_;
+    size_t mask_;
+    // Индексы потребителя и производителя в разных строках кэша
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+    alignas(64) std::atomic<bool> closed_;
+    std::atomic<bool> cancelled_;
+
+    // Короткое ожидание активным опросом, затем уступаем процессор
+    static void backoff(unsigned& spins)
+    {
+        if (++spins < 64) {
+            return;
+        }
+        if (spins < 256) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+};
+
+#endif // SPSCRING_H
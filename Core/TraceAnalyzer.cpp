@@ -0,0 +1,2118 @@
+#include "TraceAnalyzer.h"
+#include "BinaryTrace.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "SpscRing.h"
+#include "CNF/MinisatBackend.h"
+
+namespace {
+
+const int kMaxCallDepth = 64;           // Глубина вложенных вызовов функций трассы
+const int kCallSitePosition = -2;       // Позиция соединения сводки: id строки вызова
+
+} // namespace
+
+TraceAnalyzer::TraceAnalyzer()
+    : treeManager_(new TreeManager()),
+    has_error_(false),
+    tree_error_reported_(false),
+    has_memory_leak_(false),
+    current_tree_(nullptr),
+    memory_var_index_(0),
+    compact_positions_(false),
+    site_summary_limit_(0),
+    fail_fast_(false),
+    stopped_on_leak_(false),
+    fail_fast_row_(-1),
+    call_depth_(0),
+    checkpoint_(nullptr),
+    checkpoint_interval_ms_(0),
+    rows_processed_(0),
+    resume_rows_(0),
+    resume_source_size_(-1),
+    source_size_(-1),
+    pipeline_enabled_(true),
+    pipeline_depth_(1024),
+    solver_(new MinisatBackend()),
+    portfolio_(nullptr),
+    portfolio_threshold_(0),
+    solve_cache_(nullptr),
+    solve_timeout_ms_(0),
+    trace_time_limit_ms_(0),
+    time_limit_exceeded_(false),
+    dimacs_dump_count_(0),
+    show_model_(false),
+    report_mode_(FullReport),
+    full_dump_requested_(false),
+    session_active_(false),
+    out_(&std::cout)
+{
+}
+TraceAnalyzer::~TraceAnalyzer()
+{
+    delete checkpoint_;
+    delete solver_;
+    delete portfolio_;
+    delete treeManager_;
+}
+int64_t TraceAnalyzer::fileSize(const std::string& file_path)
+{
+    std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return -1;
+    }
+    return static_cast<int64_t>(file.tellg());
+}
+bool TraceAnalyzer::parseBinaryFile(const std::string& file_path)
+{
+    BinaryTraceReader reader;
+    if (!reader.open(file_path)) {
+        output() << "Error: " << reader.errorString() << std::endl;
+        has_error_ = true;
+        return false;
+    }
+    return analyze(reader, fileSize(file_path));
+}
+bool TraceAnalyzer::analyze(TraceSource& source, int64_t source_size)
+{
+    if (!beginSession(source_size)) {
+        return false;
+    }
+    output() << "=== Starting parsing of " << source.rowCount() << " rows ===" << std::endl;
+    // Строки, учтенные в восстановленной контрольной точке, не анализируются повторно
+    // Трасса короче контрольной точки: точка снята с другой трассы
+    if (resume_rows_ > 0 && !source.skip(resume_rows_)) {
+        if (source.hasError()) {
+            output() << "Error: " << source.errorString() << std::endl;
+        } else {
+            output() << "Error: Checkpoint was written for a different trace: trace has fewer than "
+                     << resume_rows_ << " rows" << std::endl;
+        }
+        has_error_ = true;
+        abortSession();
+        return false;
+    }
+    bool ok = analyzeRows([&source](DecodedRow& row) {
+        row.error.clear();
+        if (source.next(row.statement)) {
+            return true;
+        }
+        if (source.hasError()) {
+            row.error = source.errorString();
+            return true;
+        }
+        return false;
+    });
+    // Досрочная остановка — не ошибка: сеанс закрывается без финального анализа
+    if (!ok && !isStopped()) {
+        abortSession();
+        return false;
+    }
+    return finishSession();
+}
+bool TraceAnalyzer::analyzeRows(const RowSource& next_row)
+{
+    if (!pipeline_enabled_) {
+        DecodedRow row;
+        while (next_row(row)) {
+            if (!consumeRow(row)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    // Декодирование идет в отдельном потоке и передается анализу через кольцевой буфер;
+    // заполненный буфер притормаживает декодер
+    SpscRing<DecodedRow> ring(pipeline_depth_);
+    std::thread decoder([&ring, &next_row]() {
+        DecodedRow row;
+        while (next_row(row)) {
+            bool failed = !row.error.empty();
+            if (!ring.push(std::move(row)) || failed) {
+                break;
+            }
+            row = DecodedRow();
+        }
+        ring.close();
+    });
+    DecodedRow row;
+    bool ok = true;
+    while (ring.pop(row)) {
+        if (!consumeRow(row)) {
+            ok = false;
+            break;
+        }
+    }
+    ring.cancel();
+    decoder.join();
+    return ok;
+}
+bool TraceAnalyzer::consumeRow(const DecodedRow& row)
+{
+    if (!row.error.empty()) {
+        output() << "Error: " << row.error << std::endl;
+        has_error_ = true;
+        return false;
+    }
+    return pushRow(row.statement);
+}
+bool TraceAnalyzer::beginSession(int64_t source_size)
+{
+    if (session_active_) {
+        output() << "Error: Analysis session already started" << std::endl;
+        return false;
+    }
+    source_size_ = source_size;
+    // Размер сверяется, только если источник его знает (у строк из памяти его нет)
+    if (resume_rows_ > 0 && source_size_ >= 0 && resume_source_size_ >= 0
+        && resume_source_size_ != source_size_) {
+        output() << "Error: Checkpoint was written for a different trace file" << std::endl;
+        has_error_ = true;
+        return false;
+    }
+    if (checkpoint_) {
+        checkpoint_started_ = std::chrono::steady_clock::now();
+    }
+    rows_processed_ = resume_rows_;
+    trace_deadline_ = SolveWatchdog::Clock::now() + std::chrono::milliseconds(trace_time_limit_ms_);
+    session_active_ = true;
+    return true;
+}
+bool TraceAnalyzer::pushRow(const TraceStatement& row)
+{
+    if (!session_active_) {
+        output() << "Error: Analysis session is not started" << std::endl;
+        return false;
+    }
+    // Ошибки использования сеанса не портят состояние анализа; после ошибки анализа
+    // сеанс строки не принимает
+    if (has_error_ || isStopped() || !processRow(row)) {
+        return false;
+    }
+    ++rows_processed_;
+    if (full_dump_requested_.exchange(false)) {
+        dumpAllTrees();
+    }
+    maybeWriteCheckpoint();
+    treeManager_->releaseColdTrees(current_tree_);
+    if (treeManager_->hasError()) {
+        reportTreeManagerError();
+        return false;
+    }
+    return true;
+}
+bool TraceAnalyzer::pushRows(const std::vector<TraceStatement>& rows)
+{
+    for (const TraceStatement& row : rows) {
+        if (!pushRow(row)) {
+            return false;
+        }
+    }
+    return true;
+}
+bool TraceAnalyzer::finishSession()
+{
+    if (!session_active_) {
+        output() << "Error: Analysis session is not started" << std::endl;
+        return false;
+    }
+    session_active_ = false;
+    if (has_error_) {
+        return false;
+    }
+    if (isStopped()) {
+        return true;
+    }
+    return finishAnalysis();
+}
+int TraceAnalyzer::unknownVerdictCount() const
+{
+    int count = 0;
+    for (const auto& entry : reported_trees_) {
+        if (entry.second.unknown) {
+            ++count;
+        }
+    }
+    return count;
+}
+std::vector<TraceAnalyzer::TreeVerdict> TraceAnalyzer::currentVerdicts() const
+{
+    std::vector<TreeVerdict> verdicts;
+    for (const auto& entry : treeManager_->getAllTrees()) {
+        TreeVerdict verdict;
+        verdict.tree = entry.first;
+        verdict.has_leak = false;
+        verdict.unknown = false;
+        verdict.up_to_date = false;
+        auto reported = reported_trees_.find(entry.first);
+        if (reported != reported_trees_.end()) {
+            verdict.has_leak = reported->second.has_leak;
+            verdict.unknown = reported->second.unknown;
+            verdict.up_to_date = reported->second.generation == entry.second->getGeneration();
+        }
+        verdicts.push_back(verdict);
+    }
+    return verdicts;
+}
+void TraceAnalyzer::enableCheckpoints(const std::string& path, int interval_seconds)
+{
+    delete checkpoint_;
+    checkpoint_ = new CheckpointStore(path);
+    checkpoint_interval_ms_ = static_cast<int64_t>(interval_seconds) * 1000;
+    checkpoint_started_ = std::chrono::steady_clock::now();
+}
+void TraceAnalyzer::maybeWriteCheckpoint()
+{
+    if (!checkpoint_) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (std::chrono::duration_cast<std::chrono::milliseconds>(now - checkpoint_started_).count()
+        < checkpoint_interval_ms_) {
+        return;
+    }
+    writeCheckpoint();
+    checkpoint_started_ = now;
+}
+bool TraceAnalyzer::writeCheckpoint()
+{
+    if (!checkpoint_) {
+        return false;
+    }
+    CheckpointState state;
+    state.rows_processed = rows_processed_;
+    state.source_size = source_size_;
+    state.memory_var_index = memory_var_index_;
+    state.has_memory_leak = has_memory_leak_;
+    state.current_tree = current_tree_ ? current_tree_->getName() : std::string();
+    state.position_high_water = positions_.highWater();
+    state.free_positions = positions_.freePositions();
+    if (!functions_.empty()) {
+        BinaryTraceWriter definitions;
+        for (const auto& function : functions_) {
+            definitions.addRow(function.second.definition);
+        }
+        state.functions = definitions.toBytes();
+    }
+    for (const auto& site : site_nodes_) {
+        for (const std::string& name : site.second) {
+            state.summary_nodes.push_back({name, site.first, summary_nodes_[name].blocks});
+        }
+    }
+    if (!checkpoint_->save(state, *treeManager_)) {
+        // Сбой записи не прерывает анализ
+        output() << "Warning: " << checkpoint_->errorString() << std::endl;
+        return false;
+    }
+    output() << "Checkpoint written after row " << rows_processed_
+              << " (" << (checkpoint_->lastWasSnapshot() ? "snapshot" : "delta")
+              << ", " << checkpoint_->lastTreeCount() << " trees)" << std::endl;
+    return true;
+}
+bool TraceAnalyzer::resumeFrom(const std::string& path)
+{
+    CheckpointStore store(path);
+    CheckpointState state;
+    if (!store.load(state, *treeManager_, &positions_)) {
+        output() << "Error: " << store.errorString() << std::endl;
+        has_error_ = true;
+        return false;
+    }
+    memory_var_index_ = state.memory_var_index;
+    functions_.clear();
+    if (!state.functions.empty()) {
+        BinaryTraceReader definitions;
+        TraceStatement definition;
+        if (definitions.load(state.functions)) {
+            while (definitions.next(definition)) {
+                defineFunction(definition);
+            }
+        }
+        if (definitions.hasError()) {
+            output() << "Error: Corrupted function definitions in checkpoint: " << definitions.errorString() << std::endl;
+            has_error_ = true;
+            return false;
+        }
+    }
+    summary_nodes_.clear();
+    site_nodes_.clear();
+    for (const CheckpointState::SummaryNode& node : state.summary_nodes) {
+        summary_nodes_[node.name] = {node.site, node.blocks};
+        site_nodes_[node.site].push_back(node.name);
+    }
+    has_memory_leak_ = state.has_memory_leak;
+    current_tree_ = loadTree(state.current_tree);
+    if (has_error_) {
+        return false;
+    }
+    resume_rows_ = state.rows_processed;
+    resume_source_size_ = state.source_size;
+    output() << "Resumed from checkpoint: " << resume_rows_ << " rows already processed, "
+              << treeManager_->getTreeCount() << " trees restored" << std::endl;
+    return true;
+}
+bool TraceAnalyzer::processRow(const TraceStatement& row)
+{
+    int clause_id = row.id;
+    output() << "\n=== Processing row " << clause_id << " ===" << std::endl;
+    // Обработка переменной
+    if (row.kind == TraceStatement::Variable) {
+        const std::string& var_name = row.variable;
+        output() << "Processing variable: " << var_name << std::endl;
+        // Создаем или получаем дерево для этой переменной
+        if (!treeManager_->containsTree(var_name)) {
+            Tree* new_tree = new Tree(var_name);
+            new_tree->setPositionAllocator(&positions_);
+            new_tree->setEventRecording(report_mode_ == DeltaReport);
+            treeManager_->addTree(var_name, new_tree);
+            // Создаем корневой элемент
+            TreeElement root_element = new_tree->addElement(var_name, TreeElement::ROOT, acquirePosition());
+            new_tree->setRoot(root_element);
+            output() << "Created new tree: " << var_name << std::endl;
+        }
+        current_tree_ = loadTree(var_name);
+        if (!current_tree_) {
+            output() << "Error: Parsing error at row: " << clause_id << std::endl;
+            return false;
+        }
+        const TraceValue& val = row.value;
+        if (val.kind == TraceValue::Null) {
+            output() << "Assigning null to variable" << std::endl;
+            handleNullAssignment(current_tree_, var_name, clause_id);
+            // Строки с присваиванием null не запускают анализ деревьев
+            return true;
+        } else if (val.kind == TraceValue::Operation) {
+            std::string operation = val.operationName();
+            output() << "Handling memory operation '" << operation
+                      << "' for: " << var_name << std::endl;
+            if (isAllocationOp(val.op)) {
+                handleMemoryAllocation(current_tree_, var_name, clause_id, operation);
+            } else if (isDeallocationOp(val.op)) {
+                handleFree(current_tree_, var_name);
+            } else {
+                output() << "Warning: Unknown memory operation: " << operation << std::endl;
+            }
+        } else if (val.kind == TraceValue::Nested || val.kind == TraceValue::InvalidNested) {
+            output() << "Processing nested value for: " << var_name << std::endl;
+            processNestedValue(val, current_tree_, var_name, clause_id);
+        } else if (val.kind == TraceValue::Absent && row.field) {
+            output() << "Processing structure field for: " << var_name << std::endl;
+            processStructureField(*row.field, current_tree_, var_name, clause_id);
+        }
+    }
+    // Определение функции не требует дерева: тело выполняется только при вызовах
+    else if (row.kind == TraceStatement::Operation && row.operation == TraceStatement::Function) {
+        defineFunction(row);
+    }
+    // Обработка операции
+    else if (row.kind == TraceStatement::Operation) {
+        output() << "Processing operation" << std::endl;
+        if (!current_tree_) {
+            output() << "Warning: Operation without current tree, using first available tree" << std::endl;
+            if (!treeManager_->getAllTrees().empty()) {
+                current_tree_ = loadTree(treeManager_->getAllTrees().begin()->first);
+            }
+        }
+        if (current_tree_) {
+            processOperation(row, current_tree_, clause_id);
+        } else {
+            output() << "Error: No tree available for operation" << std::endl;
+            has_error_ = true;
+        }
+    } else {
+        output() << "Warning: Row " << clause_id << " doesn't contain variable or operation" << std::endl;
+    }
+    // Перенумеровываем позиции, если освобожденных стало больше, чем живых
+    if (compact_positions_ && positions_.freeCount() > positions_.liveCount()) {
+        compactPositions();
+    }
+    if (!has_error_) {
+        analyzeTreesAfterRow(clause_id);
+    }
+    if (treeManager_->hasError()) {
+        reportTreeManagerError();
+    }
+    if (has_error_) {
+        output() << "Error: Parsing error at row: " << clause_id << std::endl;
+        return false;
+    }
+    if (stoppedOnLeak()) {
+        output() << "\nFAIL-FAST: Memory leak in tree '" << fail_fast_tree_
+                  << "' at row " << fail_fast_row_ << ", analysis stopped" << std::endl;
+        return false;
+    }
+    if (trace_time_limit_ms_ > 0 && SolveWatchdog::Clock::now() >= trace_deadline_) {
+        time_limit_exceeded_ = true;
+        output() << "\nTIME LIMIT: Trace time limit of " << trace_time_limit_ms_ / 1000
+                  << " s exceeded at row " << clause_id << ", analysis stopped" << std::endl;
+        return false;
+    }
+    output() << "=== Completed row " << clause_id << " ===\n" << std::endl;
+    return true;
+}
+void TraceAnalyzer::analyzeTreesAfterRow(int clause_id)
+{
+    solver_stats_.beginRow();
+    if (report_mode_ == DeltaReport) {
+        analyzeChangedTrees(clause_id);
+    } else {
+        analyzeAllTrees(clause_id);
+    }
+    solver_stats_.endRow();
+}
+void TraceAnalyzer::analyzeAllTrees(int clause_id)
+{
+    // После обработки каждой строки выполняем solveCNF для ВСЕХ деревьев
+    output() << "\n=== Solving CNF for ALL trees after row " << clause_id << " ===" << std::endl;
+    const std::map<std::string, Tree*>& all_trees = treeManager_->getAllTrees();
+    output() << "Total trees: " << all_trees.size() << std::endl;
+    reported_trees_.clear();
+    bool any_leak_detected_current_row = false; // локальная переменная для текущей строки
+    std::string first_leak_tree;
+    for (auto it = all_trees.begin(); it != all_trees.end(); ++it) {
+        Tree* tree = loadTree(it->first);
+        if (!tree) {
+            return;
+        }
+        output() << "\n--- Analyzing tree: " << tree->getName() << " ---" << std::endl;
+        printTreeState(tree);
+        // Решаем CNF для этого дерева
+        TreeSolution::Verdict verdict = solveCNF(tree);
+        bool tree_has_leak = verdict == TreeSolution::Leak;
+        reported_trees_[it->first] = {tree->getGeneration(), tree_has_leak, verdict == TreeSolution::Unknown};
+        if (verdict == TreeSolution::Unknown) {
+            output() << "❔ Verdict unknown for tree '"
+                      << tree->getName() << "' at row " << clause_id << std::endl;
+        } else if (tree_has_leak) {
+            output() << "❌ MEMORY LEAK DETECTED in tree '"
+                      << tree->getName() << "' at row " << clause_id << std::endl;
+            if (!any_leak_detected_current_row) {
+                first_leak_tree = it->first;
+            }
+            any_leak_detected_current_row = true; 
+            // Остановка на первой утечке: остальные деревья строки не решаются
+            if (fail_fast_) {
+                break;
+            }
+        } else {
+            output() << "✅ No memory leak in tree '"
+                      << tree->getName() << "' at row " << clause_id << std::endl;
+        }
+        treeManager_->trimToBudget(current_tree_);
+    }
+    // Устанавливаем глобальный флаг только если в ЭТОЙ строке обнаружена утечка
+    if (any_leak_detected_current_row) {
+        has_memory_leak_ = true;
+        output() << "\nOVERALL: Memory leak detected at row " << clause_id << std::endl;
+        stopOnLeak(first_leak_tree, clause_id);
+    } else {
+        output() << "\nOVERALL: No memory leaks detected at row " << clause_id << std::endl;
+    }
+}
+void TraceAnalyzer::analyzeChangedTrees(int clause_id)
+{
+    // Решаются и выводятся только деревья, изменившиеся после прошлого решения:
+    // у неизменного дерева (то же поколение) вердикт прежний
+    output() << "\n=== Changes after row " << clause_id << " ===" << std::endl;
+    const std::map<std::string, Tree*>& all_trees = treeManager_->getAllTrees();
+    for (auto it = reported_trees_.begin(); it != reported_trees_.end();) {
+        if (all_trees.find(it->first) == all_trees.end()) {
+            output() << "Tree removed: " << it->first << std::endl;
+            it = reported_trees_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    bool any_leak_detected_current_row = false;
+    std::string first_leak_tree;
+    for (auto it = all_trees.begin(); it != all_trees.end(); ++it) {
+        auto reported = reported_trees_.find(it->first);
+        const bool known = reported != reported_trees_.end();
+        // Вытесненное дерево не менялось: поколение доступно без восстановления
+        if (known && reported->second.generation == it->second->getGeneration()) {
+            solver_stats_.addSkip(SolverStats::UnchangedTree);
+            if (reported->second.has_leak && !any_leak_detected_current_row) {
+                first_leak_tree = it->first;
+            }
+            any_leak_detected_current_row = any_leak_detected_current_row || reported->second.has_leak;
+            continue;
+        }
+        Tree* tree = loadTree(it->first);
+        if (!tree) {
+            return;
+        }
+        output() << "\n--- Tree: " << tree->getName() << " ---" << std::endl;
+        if (!tree->isRecordingEvents()) {
+            // Дерево появилось без записи событий (восстановлено из контрольной точки):
+            // один раз выводим его целиком
+            tree->setEventRecording(true);
+            printTreeState(tree);
+        }
+        for (const TreeEvent& event : tree->takeEvents()) {
+            printTreeEvent(event);
+        }
+        TreeSolution::Verdict verdict = solveCNF(tree);
+        bool tree_has_leak = verdict == TreeSolution::Leak;
+        bool tree_unknown = verdict == TreeSolution::Unknown;
+        if (!known || reported->second.has_leak != tree_has_leak || reported->second.unknown != tree_unknown) {
+            output() << (tree_unknown ? "❔ Verdict unknown" : tree_has_leak ? "❌ MEMORY LEAK DETECTED" : "✅ No memory leak")
+                      << " in tree '" << tree->getName() << "' at row " << clause_id
+                      << (known ? " (verdict changed)" : "") << std::endl;
+        }
+        reported_trees_[it->first] = {tree->getGeneration(), tree_has_leak, tree_unknown};
+        if (tree_has_leak && !any_leak_detected_current_row) {
+            first_leak_tree = it->first;
+        }
+        any_leak_detected_current_row = any_leak_detected_current_row || tree_has_leak;
+        if (tree_has_leak && fail_fast_) {
+            break;
+        }
+        treeManager_->trimToBudget(current_tree_);
+    }
+    if (any_leak_detected_current_row) {
+        has_memory_leak_ = true;
+        stopOnLeak(first_leak_tree, clause_id);
+    }
+}
+Tree* TraceAnalyzer::loadTree(const std::string& name)
+{
+    Tree* tree = treeManager_->getTree(name);
+    if (!tree && treeManager_->hasError()) {
+        reportTreeManagerError();
+    }
+    return tree;
+}
+void TraceAnalyzer::reportTreeManagerError()
+{
+    if (!tree_error_reported_) {
+        output() << "Error: " << treeManager_->errorString() << std::endl;
+        tree_error_reported_ = true;
+    }
+    has_error_ = true;
+}
+void TraceAnalyzer::stopOnLeak(const std::string& tree_name, int clause_id)
+{
+    if (!fail_fast_ || stoppedOnLeak()) {
+        return;
+    }
+    stopped_on_leak_ = true;
+    fail_fast_tree_ = tree_name;
+    fail_fast_row_ = clause_id;
+}
+void TraceAnalyzer::printTreeState(const Tree* tree) const
+{
+    // Выводим все соединения дерева с правильной логикой векторов
+    output() << "Connections (" << tree->getConnectionCount() << "):" << std::endl;
+    for (const Connection& conn : tree->getConnections()) {
+        output() << " " << conn.getFrom() << " -> " << conn.getTo();
+        output() << " [pos:" << conn.getPosition() << "]" << std::endl;
+        // Выводим векторы с правильными пояснениями
+        output() << " Positive positions (TO " << conn.getTo() << "): ";
+        if (conn.getPositiveLiteral() >= 0) {
+            output() << conn.getPositiveLiteral() << " ";
+        }
+        output() << std::endl;
+        output() << " Negative positions (FROM " << conn.getFrom() << "): ";
+        if (conn.getNegativeLiteral() >= 0) {
+            output() << conn.getNegativeLiteral() << " ";
+        }
+        output() << std::endl;
+    }
+    // Выводим все элементы
+    output() << "Elements (" << tree->getElementCount() << "):" << std::endl;
+    for (const TreeElement& element : tree->getElements()) {
+        output() << " " << element.getName()
+                  << " [type:" << element.getTypeName()
+                  << ", pos:" << element.getPosition()
+                  << "]" << std::endl;
+    }
+}
+void TraceAnalyzer::printTreeEvent(const TreeEvent& event) const
+{
+    switch (event.kind) {
+    case TreeEvent::ElementAdded:
+        output() << " + element " << event.name << " [pos:" << event.position << "]" << std::endl;
+        break;
+    case TreeEvent::ElementRemoved:
+        output() << " - element " << event.name << " [pos:" << event.position << "]" << std::endl;
+        break;
+    case TreeEvent::ConnectionAdded:
+        output() << " + connection " << event.name << " -> " << event.target
+                  << " [pos:" << event.position << "]" << std::endl;
+        break;
+    case TreeEvent::ConnectionRemoved:
+        output() << " - connection " << event.name << " -> " << event.target
+                  << " [pos:" << event.position << "]" << std::endl;
+        break;
+    case TreeEvent::RootChanged:
+        output() << " * root " << (event.name.empty() ? "None" : event.name) << std::endl;
+        break;
+    case TreeEvent::ElementsCleared:
+        output() << " - all elements" << std::endl;
+        break;
+    case TreeEvent::ConnectionsCleared:
+        output() << " - all connections" << std::endl;
+        break;
+    case TreeEvent::PositionsRemapped:
+        output() << " * positions renumbered" << std::endl;
+        break;
+    }
+}
+void TraceAnalyzer::dumpAllTrees() const
+{
+    const std::map<std::string, Tree*>& all_trees = treeManager_->getAllTrees();
+    output() << "\n=== Full dump after row " << rows_processed_ << ": " << all_trees.size() << " trees ===" << std::endl;
+    for (auto it = all_trees.begin(); it != all_trees.end(); ++it) {
+        output() << "\n--- Tree: " << it->first << " ---" << std::endl;
+        const Tree* tree = treeManager_->getTree(it->first);
+        if (!tree) {
+            // Ошибку восстановления выводит и обрабатывает pushRow
+            break;
+        }
+        printTreeState(tree);
+        treeManager_->trimToBudget(current_tree_);
+    }
+    output() << "=== End of full dump ===" << std::endl;
+}
+bool TraceAnalyzer::finishAnalysis()
+{
+    // Финальная проверка всех деревьев
+    output() << "=== Final Analysis of ALL Trees ===" << std::endl;
+    const std::map<std::string, Tree*>& all_trees = treeManager_->getAllTrees();
+    output() << "Total trees: " << all_trees.size() << std::endl;
+    bool final_leak_detected = false;
+    int final_unknown = 0;
+    for (auto it = all_trees.begin(); it != all_trees.end(); ++it) {
+        Tree* tree = loadTree(it->first);
+        if (!tree) {
+            return false;
+        }
+        output() << "\n--- Final state of tree: " << tree->getName() << " ---" << std::endl;
+        output() << "Elements: " << tree->getElementCount() << std::endl;
+        output() << "Connections: " << tree->getConnectionCount() << std::endl;
+        output() << "Valid: " << (tree->isValid() ? "Yes" : "No") << std::endl;
+        // Финальная проверка CNF
+        TreeSolution::Verdict verdict = solveCNF(tree);
+        bool final_leak = verdict == TreeSolution::Leak;
+        reported_trees_[it->first] = {tree->getGeneration(), final_leak, verdict == TreeSolution::Unknown};
+        if (verdict == TreeSolution::Unknown) {
+            output() << "FINAL UNKNOWN: Solver limit reached for tree '"
+                      << tree->getName() << "'" << std::endl;
+            ++final_unknown;
+        } else if (final_leak) {
+            output() << "FINAL WARNING: Memory leak in tree '"
+                      << tree->getName() << "'" << std::endl;
+            final_leak_detected = true;
+        } else {
+            output() << "FINAL: No memory leak in tree '"
+                      << tree->getName() << "'" << std::endl;
+        }
+        treeManager_->trimToBudget(current_tree_);
+    }
+    if (treeManager_->hasError()) {
+        reportTreeManagerError();
+        return false;
+    }
+    // Определяем финальный результат на основе финального анализа
+    has_memory_leak_ = final_leak_detected;
+    if (has_memory_leak_) {
+        output() << "\nFINAL RESULT: Memory leaks detected in the program" << std::endl;
+    } else if (final_unknown > 0) {
+        output() << "\nFINAL RESULT: No memory leaks detected in solved trees, verdict unknown for "
+                  << final_unknown << " tree(s)" << std::endl;
+    } else {
+        output() << "\nFINAL RESULT: No memory leaks detected" << std::endl;
+    }
+    return true;
+}
+void TraceAnalyzer::processBody(const std::vector<TraceStatement>& body, Tree* current_tree, int clause_id)
+{
+    for (const TraceStatement& statement : body) {
+        if (statement.kind == TraceStatement::Variable) {
+            const std::string& var_name = statement.variable;
+            findOrCreateElement(current_tree, var_name, "Variable");
+            const TraceValue& val = statement.value;
+            if (val.kind == TraceValue::Null) {
+                handleNullAssignment(current_tree, var_name, clause_id);
+            } else if (val.kind == TraceValue::Operation) {
+                // aligned_alloc внутри тела не обрабатывается (как и в строках поля)
+                if (isAllocationOp(val.op) && val.op != TraceOp::AlignedAlloc) {
+                    handleMemoryAllocation(current_tree, var_name, clause_id, val.operationName());
+                } else if (isDeallocationOp(val.op)) {
+                    handleFree(current_tree, var_name);
+                }
+            } else if (val.kind == TraceValue::Nested || val.kind == TraceValue::InvalidNested) {
+                processNestedValue(val, current_tree, var_name, clause_id);
+            } else if (val.kind == TraceValue::Absent && statement.field) {
+                processStructureField(*statement.field, current_tree, var_name, clause_id);
+            }
+        } else if (statement.kind == TraceStatement::Operation) {
+            processOperation(statement, current_tree, clause_id);
+        }
+    }
+}
+void TraceAnalyzer::processBranch(const std::vector<TraceStatement>& branch_body, Tree* current_tree, int clause_id)
+{
+    processBody(branch_body, current_tree, clause_id);
+}
+void TraceAnalyzer::processOperation(const TraceStatement& op_statement, Tree* current_tree, int clause_id)
+{
+    if (op_statement.operation == TraceStatement::InvalidOperation) {
+        has_error_ = true;
+        return;
+    }
+    if (op_statement.operation == TraceStatement::Loop) {
+        processLoop(op_statement, current_tree, clause_id);
+    } else if (op_statement.operation == TraceStatement::Function) {
+        defineFunction(op_statement);
+    } else if (op_statement.operation == TraceStatement::Call) {
+        processCall(op_statement, current_tree, clause_id);
+    } else {
+        if (op_statement.has_branch_true) {
+            processBranch(op_statement.branch_true, current_tree, clause_id);
+        }
+        if (op_statement.has_branch_false) {
+            processBranch(op_statement.branch_false, current_tree, clause_id);
+        }
+    }
+}
+void TraceAnalyzer::processLoop(const TraceStatement& loop_statement, Tree* current_tree, int clause_id)
+{
+    if (!loop_statement.loop_valid) {
+        has_error_ = true;
+        output() << "Error: Loop missing condition or body" << std::endl;
+        return;
+    }
+    // Обрабатываем тело цикла как одну итерацию
+    output() << "Warning: Loop processed as single iteration" << std::endl;
+    processBody(loop_statement.body, current_tree, clause_id);
+}
+void TraceAnalyzer::defineFunction(const TraceStatement& definition)
+{
+    std::unordered_set<std::string> params(definition.arguments.begin(), definition.arguments.end());
+    if (definition.function.empty() || params.size() != definition.arguments.size()) {
+        output() << "Error: Invalid definition of function '" << definition.function << "'" << std::endl;
+        has_error_ = true;
+        return;
+    }
+    // Повторное определение заменяет прежнее вместе со сводкой
+    TraceFunction& function = functions_[definition.function];
+    function.definition = definition;
+    function.summary = FunctionSummary();
+    output() << "Defined function: " << definition.function << " (" << definition.arguments.size()
+              << " parameters, " << definition.body.size() << " statements)" << std::endl;
+}
+void TraceAnalyzer::processCall(const TraceStatement& call, Tree* current_tree, int clause_id)
+{
+    auto it = functions_.find(call.function);
+    if (it == functions_.end()) {
+        output() << "Error: Unknown function '" << call.function << "'" << std::endl;
+        has_error_ = true;
+        return;
+    }
+    TraceFunction& function = it->second;
+    const TraceStatement& definition = function.definition;
+    if (call.arguments.size() != definition.arguments.size()) {
+        output() << "Error: Function '" << call.function << "' expects " << definition.arguments.size()
+                  << " arguments, got " << call.arguments.size() << std::endl;
+        has_error_ = true;
+        return;
+    }
+    if (call_depth_ >= kMaxCallDepth) {
+        output() << "Error: Call depth limit exceeded in function '" << call.function << "'" << std::endl;
+        has_error_ = true;
+        return;
+    }
+    output() << "Calling function: " << call.function << std::endl;
+    if (!function.summary.ready) {
+        computeSummary(function, clause_id);
+    }
+    if (function.summary.supported && applySummary(function, call, current_tree, clause_id)) {
+        return;
+    }
+    // Тело зависит от состояния вызывающего: выполняется заново с подстановкой аргументов
+    output() << "Replaying body of function '" << call.function << "'" << std::endl;
+    std::unordered_map<std::string, std::string> names;
+    for (size_t i = 0; i < call.arguments.size(); ++i) {
+        names[definition.arguments[i]] = call.arguments[i];
+    }
+    std::vector<TraceStatement> body = definition.body;
+    renameVariables(body, names);
+    ++call_depth_;
+    processBody(body, current_tree, clause_id);
+    --call_depth_;
+}
+bool TraceAnalyzer::isSelfContainedField(const TraceField& field) const
+{
+    if (!field.valid) {
+        return false;
+    }
+    if (field.op && !isSelfContainedField(*field.op)) {
+        return false;
+    }
+    return field.value.kind != TraceValue::Nested && field.value.kind != TraceValue::InvalidNested;
+}
+bool TraceAnalyzer::collectEffects(const std::vector<TraceStatement>& body, FunctionSummary& summary,
+                                   std::unordered_set<std::string>& allocated,
+                                   std::unordered_set<std::string>& freed) const
+{
+    auto remember = [](std::vector<std::string>& names, const std::string& name) {
+        if (std::find(names.begin(), names.end(), name) == names.end()) {
+            names.push_back(name);
+        }
+    };
+    // Тело не зависит от вызывающего, если читает (переходит по полям, освобождает)
+    // только память, выделенную в самом теле, и не обращается к другим деревьям
+    for (const TraceStatement& statement : body) {
+        if (statement.kind == TraceStatement::Operation) {
+            if (statement.operation == TraceStatement::Loop) {
+                if (!statement.loop_valid || !collectEffects(statement.body, summary, allocated, freed)) {
+                    return false;
+                }
+            } else if (statement.operation == TraceStatement::Branch) {
+                if ((statement.has_branch_true && !collectEffects(statement.branch_true, summary, allocated, freed))
+                    || (statement.has_branch_false && !collectEffects(statement.branch_false, summary, allocated, freed))) {
+                    return false;
+                }
+            } else {
+                return false;   // Вложенные функции и вызовы выполняются заново
+            }
+            continue;
+        }
+        if (statement.kind != TraceStatement::Variable) {
+            continue;
+        }
+        const std::string& name = statement.variable;
+        if (freed.count(name) != 0) {
+            return false;       // Использование после освобождения
+        }
+        remember(summary.variables, name);
+        const TraceValue& value = statement.value;
+        if (value.kind == TraceValue::Null) {
+            remember(summary.assigned, name);
+        } else if (value.kind == TraceValue::Operation && isAllocationOp(value.op) && value.op != TraceOp::AlignedAlloc) {
+            remember(summary.assigned, name);
+            remember(summary.allocated, name);
+            allocated.insert(name);
+        } else if (value.kind == TraceValue::Operation && isDeallocationOp(value.op)) {
+            if (allocated.count(name) == 0) {
+                return false;
+            }
+            freed.insert(name);
+            remember(summary.freed, name);
+        } else if (value.kind == TraceValue::Nested || value.kind == TraceValue::InvalidNested) {
+            return false;
+        } else if (value.kind == TraceValue::Absent && statement.field) {
+            if (allocated.count(name) == 0 || !isSelfContainedField(*statement.field)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+void TraceAnalyzer::computeSummary(TraceFunction& function, int clause_id)
+{
+    const TraceStatement& definition = function.definition;
+    FunctionSummary& summary = function.summary;
+    summary = FunctionSummary();
+    summary.ready = true;
+    std::unordered_set<std::string> allocated;
+    std::unordered_set<std::string> freed;
+    if (!collectEffects(definition.body, summary, allocated, freed)) {
+        output() << "Function '" << definition.function << "' depends on caller state, no summary" << std::endl;
+        return;
+    }
+    // Пробный прогон: корень и параметры без соединений. Имя корня не может совпасть
+    // с переменной трассы
+    Tree scratch("#" + definition.function);
+    scratch.setPositionAllocator(&positions_);
+    scratch.setRoot(scratch.addElement(scratch.getName(), TreeElement::ROOT, acquirePosition()));
+    for (const std::string& param : definition.arguments) {
+        scratch.addElement(param, TreeElement::ROOT, acquirePosition());
+    }
+    // Прогон не должен менять видимое состояние анализатора
+    const int saved_index = memory_var_index_;
+    const int saved_limit = site_summary_limit_;
+    const bool saved_error = has_error_;
+    std::ostream* saved_out = out_;
+    std::ostringstream discarded;
+    out_ = &discarded;
+    site_summary_limit_ = 0;
+    has_error_ = false;
+    ++call_depth_;
+    processBody(definition.body, &scratch, clause_id);
+    --call_depth_;
+    const bool failed = has_error_;
+    memory_var_index_ = saved_index;
+    site_summary_limit_ = saved_limit;
+    has_error_ = saved_error;
+    out_ = saved_out;
+
+    std::unordered_set<std::string> variables(summary.variables.begin(), summary.variables.end());
+    variables.insert(definition.arguments.begin(), definition.arguments.end());
+    summary.root = scratch.getName();
+    for (const TreeElement& element : scratch.getElements()) {
+        if (element.getName() != summary.root && variables.count(element.getName()) == 0) {
+            summary.elements.emplace_back(element.getName(), element.getType());
+        }
+    }
+    for (const Connection& conn : scratch.getConnections()) {
+        summary.links.push_back({conn.getFrom(), conn.getTo(),
+                                 conn.getPosition() == clause_id ? kCallSitePosition : conn.getPosition()});
+    }
+    // Позиции пробного дерева возвращаются распределителю
+    for (const TreeElement& element : scratch.getElements()) {
+        positions_.release(element.getPosition());
+    }
+    summary.supported = !failed;
+    output() << "Computed summary of function '" << definition.function << "': "
+              << summary.elements.size() << " new elements, " << summary.links.size() << " connections"
+              << (failed ? " (failed, body will be replayed)" : "") << std::endl;
+}
+bool TraceAnalyzer::applySummary(const TraceFunction& function, const TraceStatement& call, Tree* tree, int clause_id)
+{
+    const TraceStatement& definition = function.definition;
+    const FunctionSummary& summary = function.summary;
+    std::unordered_map<std::string, std::string> names;
+    names[summary.root] = tree->getName();
+    for (size_t i = 0; i < call.arguments.size(); ++i) {
+        names[definition.arguments[i]] = call.arguments[i];
+    }
+    // Сводка точна, только если переменные тела у вызывающего различны (аргументы
+    // не совпадают друг с другом и с локальными переменными) и не совпадают с корнем
+    // дерева (освобождение корня обрабатывается особо)
+    std::unordered_set<std::string> targets;
+    for (const std::string& variable : summary.variables) {
+        auto mapped = names.find(variable);
+        const std::string& target = mapped != names.end() ? mapped->second : variable;
+        if (target == tree->getName() || !targets.insert(target).second) {
+            return false;
+        }
+    }
+    auto target = [&](const std::string& name) -> const std::string& {
+        auto mapped = names.find(name);
+        return mapped != names.end() ? mapped->second : name;
+    };
+    // 1. Переменные тела, как при построчном выполнении
+    for (const std::string& variable : summary.variables) {
+        findOrCreateElement(tree, target(variable), "Variable");
+    }
+    // 2. Сброс прежних значений: первое присваивание в теле предшествует любому чтению
+    auto ignore = [](const Connection&) {};
+    for (const std::string& variable : summary.assigned) {
+        removeRootLinkClauses(tree, tree->getName(), target(variable));
+    }
+    for (const std::string& variable : summary.allocated) {
+        tree->removeConnectionsFrom(target(variable), ignore);
+    }
+    // 3. Освобожденные телом переменные удаляются вместе со всеми соединениями
+    for (const std::string& variable : summary.freed) {
+        tree->removeElement(target(variable));
+    }
+    // 4. Новые элементы получают свежие имена и позиции
+    for (const std::pair<std::string, int>& element : summary.elements) {
+        std::string name = "N" + std::to_string(memory_var_index_++);
+        tree->addElement(name, element.second, acquirePosition());
+        names[element.first] = name;
+    }
+    // 5. Соединения после тела
+    for (const SummaryLink& link : summary.links) {
+        const std::string& from = target(link.from);
+        const std::string& to = target(link.to);
+        TreeElement from_element = tree->findElement(from);
+        TreeElement to_element = tree->findElement(to);
+        if (from_element && to_element) {
+            linkElements(tree, from, from_element.getPosition(), to, to_element.getPosition(),
+                         link.position == kCallSitePosition ? clause_id : link.position);
+        }
+    }
+    output() << "Applied summary of function '" << definition.function << "': "
+              << summary.elements.size() << " new elements, " << summary.links.size() << " connections" << std::endl;
+    return true;
+}
+void TraceAnalyzer::renameVariables(std::vector<TraceStatement>& body,
+                                    const std::unordered_map<std::string, std::string>& names)
+{
+    auto rename = [&](std::string& name) {
+        auto it = names.find(name);
+        if (it != names.end()) {
+            name = it->second;
+        }
+    };
+    // Поля разделяются копиями строк, поэтому переименовываются их копии
+    std::function<void(std::shared_ptr<TraceField>&)> renameField = [&](std::shared_ptr<TraceField>& field) {
+        field = std::make_shared<TraceField>(*field);
+        if (field->value.kind == TraceValue::Nested) {
+            rename(field->value.text);
+        }
+        if (field->op) {
+            renameField(field->op);
+        }
+    };
+    for (TraceStatement& statement : body) {
+        if (statement.kind == TraceStatement::Variable) {
+            rename(statement.variable);
+            if (statement.value.kind == TraceValue::Nested) {
+                rename(statement.value.text);
+            }
+            if (statement.field) {
+                renameField(statement.field);
+            }
+        } else if (statement.kind == TraceStatement::Operation) {
+            renameVariables(statement.body, names);
+            renameVariables(statement.branch_true, names);
+            renameVariables(statement.branch_false, names);
+            if (statement.operation == TraceStatement::Call) {
+                for (std::string& argument : statement.arguments) {
+                    rename(argument);
+                }
+            }
+        }
+    }
+}
+void TraceAnalyzer::processStructureField(const TraceField& field,
+                                        Tree* current_tree,
+                                        const std::string& var_name,
+                                        int clause_id)
+{
+    if (!field.valid) {
+        output() << "Error: Field value is not an object" << std::endl;
+        has_error_ = true;
+        return;
+    }
+    std::string current_var_name = var_name;
+    output() << "Starting structure field processing for: " << var_name << std::endl;
+    // УДАЛЯЕМ СВЯЗИ С КОРНЕМ для исходной переменной
+    removeRootLinkClauses(current_tree, current_tree->getName(), var_name);
+    if (field.has_direction) {
+        output() << "Navigating to field: " << field.direction << std::endl;
+        // Переходим по полю (left или right) и получаем целевую переменную
+        std::string target_var_name = navigateByField(current_tree, current_var_name, field.dir, field.direction, clause_id);
+        if (target_var_name.empty()) {
+            output() << "Failed to navigate to field" << std::endl;
+            return;
+        }
+        current_var_name = target_var_name;
+        output() << "Successfully navigated to: " << current_var_name << std::endl;
+        // УДАЛЯЕМ СВЯЗИ С КОРНЕМ для целевой переменной
+        removeRootLinkClauses(current_tree, current_tree->getName(), current_var_name);
+    }
+    TreeElement element = current_tree->findElement(current_var_name);
+    if (!element) {
+        output() << "Error: Element '" << current_var_name << "' not found after navigation" << std::endl;
+        has_error_ = true;
+        return;
+    }
+    // ОБРАБАТЫВАЕМ ПОЛЕ "op" - рекурсивно вызываем processStructureField
+    if (field.op) {
+        output() << "Processing op field for: " << current_var_name << std::endl;
+        processStructureField(*field.op, current_tree, current_var_name, clause_id);
+    }
+    // Обрабатываем поле "value" только если нет "op"
+    const TraceValue& value = field.value;
+    if (value.kind != TraceValue::Absent) {
+        if (value.kind == TraceValue::Null) {
+            output() << "Assigning null to field" << std::endl;
+            handleNullAssignment(current_tree, current_var_name, clause_id);
+            return;
+        } else if (value.kind == TraceValue::Operation) {
+            if (isAllocationOp(value.op) && value.op != TraceOp::AlignedAlloc) {
+                handleMemoryAllocation(current_tree, current_var_name, clause_id, value.operationName());
+            } else if (isDeallocationOp(value.op)) {
+                handleFree(current_tree, current_var_name);
+            }
+        } else if (value.kind == TraceValue::Nested || value.kind == TraceValue::InvalidNested) {
+            output() << "Processing nested value for: " << current_var_name << std::endl;
+            processNestedValue(value, current_tree, current_var_name, clause_id);
+        }
+    } else {
+        output() << "No value specified for field, navigation completed" << std::endl;
+    }
+}
+std::string TraceAnalyzer::navigateByField(Tree* tree, const std::string& current_name, FieldDirection direction,
+                                           const std::string& field_direction, int clause_id)
+{
+    TreeElement current_element = tree->findElement(current_name);
+    if (!current_element) {
+        output() << "Error: Current element '" << current_name << "' not found" << std::endl;
+        has_error_ = true;
+        return std::string();
+    }
+    output() << "Looking for " << field_direction << " field from " << current_name
+              << " [type: " << current_element.getTypeName() << "]" << std::endl;
+    // Определяем нужный тип в зависимости от направления
+    // (направление разобрано декодером при чтении строки)
+    int required_type;
+    if (direction == FieldDirection::Left) {
+        required_type = TreeElement::LEFT_VARIABLE;
+    } else if (direction == FieldDirection::Right) {
+        required_type = TreeElement::RIGHT_VARIABLE;
+    } else {
+        output() << "Error: Unknown field direction '" << field_direction << "'" << std::endl;
+        has_error_ = true;
+        return std::string();
+    }
+    // Результат прошлого поиска действителен, пока структура дерева не менялась
+    const int field_code = static_cast<int>(direction);
+    TreeElement cached_element = tree->findCachedNavigation(current_element.getId(), field_code);
+    if (cached_element) {
+        output() << "Found cached " << field_direction
+                  << " field: " << current_name
+                  << " -> " << cached_element.getName()
+                  << " [type: " << cached_element.getTypeName() << "]" << std::endl;
+        return cached_element.getName();
+    }
+    // Сначала ищем ПРЯМЫЕ связи от текущего элемента к элементам нужного типа
+    const Tree::ConnectionRange connections_from = tree->getConnectionsFrom(current_name);
+    output() << " Direct connections from " << current_name << ": ";
+    for (const Connection& conn : connections_from) {
+        output() << conn.getTo() << " ";
+    }
+    output() << std::endl;
+    for (const Connection& conn : connections_from) {
+        TreeElement target_element = conn.getToElement();
+        if (target_element.getType() == required_type) {
+            output() << "Found direct " << field_direction
+                      << " connection: " << current_name
+                      << " -> " << target_element.getName()
+                      << " [type: " << target_element.getTypeName() << "]" << std::endl;
+            tree->cacheNavigation(current_element.getId(), field_code, target_element.getId());
+            return target_element.getName();
+        }
+    }
+    // Если прямых связей нет, ищем через память (MEMORY элементы)
+    TreeElement unmaterialized_memory;
+    for (const Connection& conn : connections_from) {
+        TreeElement intermediate_element = conn.getToElement();
+        if (intermediate_element.isMemory()) {
+            output() << "Found memory element: " << intermediate_element.getName() << std::endl;
+            // Ищем от memory элемента связи к элементам нужного типа
+            for (const Connection& mem_conn : tree->getConnectionsFrom(intermediate_element.getName())) {
+                TreeElement target_element = mem_conn.getToElement();
+                if (target_element.getType() == required_type) {
+                    output() << "Found " << field_direction
+                              << " via memory: " << current_name
+                              << " -> " << intermediate_element.getName()
+                              << " -> " << target_element.getName()
+                              << " [type: " << target_element.getTypeName() << "]" << std::endl;
+                    tree->cacheNavigation(current_element.getId(), field_code, target_element.getId());
+                    return target_element.getName();
+                }
+            }
+            // Поля этой памяти еще не создавались: создаем их при первом обращении.
+            // Соединения меняются, поэтому обход прерывается
+            if (!hasFieldElements(tree, intermediate_element)) {
+                unmaterialized_memory = intermediate_element;
+                break;
+            }
+        }
+    }
+    if (unmaterialized_memory) {
+        const std::string memory_name = unmaterialized_memory.getName();
+        materializeFields(tree, unmaterialized_memory, clause_id);
+        for (const Connection& mem_conn : tree->getConnectionsFrom(memory_name)) {
+            TreeElement target_element = mem_conn.getToElement();
+            if (target_element.getType() == required_type) {
+                output() << "Found " << field_direction
+                          << " via memory: " << current_name
+                          << " -> " << memory_name
+                          << " -> " << target_element.getName()
+                          << " [type: " << target_element.getTypeName() << "]" << std::endl;
+                tree->cacheNavigation(current_element.getId(), field_code, target_element.getId());
+                return target_element.getName();
+            }
+        }
+    }
+    // Если не нашли подходящий элемент - это ошибка
+    output() << "Error: No " << field_direction
+              << " variable found for element '" << current_name << "'" << std::endl;
+    // Выводим отладочную информацию о доступных элементах
+    output() << " Available elements in tree: ";
+    for (const TreeElement& element : tree->findElementsByType(required_type)) {
+        output() << element.getName() << "[" << element.getTypeName() << "] ";
+    }
+    output() << std::endl;
+    has_error_ = true;
+    return std::string();
+}
+void TraceAnalyzer::processNestedValue(const TraceValue& value,
+                                     Tree* current_tree,
+                                     const std::string& var_name,
+                                     int clause_id)
+{
+    if (value.kind != TraceValue::Nested) {
+        output() << "Error: Nested value missing 'variable' field" << std::endl;
+        has_error_ = true;
+        return;
+    }
+    std::string nested_var_name = value.text;
+    output() << "Processing nested variable assignment: " << var_name
+              << " = " << nested_var_name << " at clause " << clause_id << std::endl;
+    TreeElement target_element = current_tree->findElement(var_name);
+    if (!target_element) {
+        output() << "Error: Target element '" << var_name << "' not found" << std::endl;
+        has_error_ = true;
+        return;
+    }
+    output() << "Target element: " << target_element.getName()
+              << " [pos: " << target_element.getPosition() << "]" << std::endl;
+    // Удаляем связи с корнем для целевого элемента
+    removeRootLinkClauses(current_tree, current_tree->getName(), var_name);
+    // Удаляем предыдущую связь
+    current_tree->removeConnectionsFrom(var_name, [&](const Connection& prev) {
+        output() << "Removed previous assignment: " << var_name << " -> " << prev.getTo() << std::endl;
+    });
+    // Проверяем, существует ли nested_var_name в текущем дереве
+    TreeElement source_element = current_tree->findElement(nested_var_name);
+    if (source_element) {
+        output() << "Source element found in current tree: " << source_element.getName() << std::endl;
+        // Если переменная существует в текущем дереве - создаем связь между ними
+        output() << "Creating connection within same tree: " << var_name
+                  << " -> " << nested_var_name << std::endl;
+        // TO: source (положительный), FROM: target (отрицательный)
+        linkElements(current_tree, var_name, target_element.getPosition(),
+                                                   nested_var_name, source_element.getPosition(), clause_id);
+        output() << "Connection created successfully: " << var_name
+                  << " -> " << nested_var_name << std::endl;
+    } else {
+        output() << "Source element not found in current tree, checking other trees..." << std::endl;
+        // Если переменная не найдена в текущем дереве, проверяем другие деревья
+        Tree* source_tree = loadTree(nested_var_name);
+        if (has_error_) {
+            return;
+        }
+        if (source_tree && source_tree != current_tree) {
+            output() << "Found source tree: " << source_tree->getName() << std::endl;
+            // Находим память (элемент MEMORY) в source_tree для создания связи
+            TreeElement source_memory_element = findMemoryElement(source_tree);
+            if (!source_memory_element) {
+                output() << "Error: No memory element found in source tree" << std::endl;
+                has_error_ = true;
+                return;
+            }
+            output() << "Source memory element: " << source_memory_element.getName()
+                      << " [pos: " << source_memory_element.getPosition() << "]" << std::endl;
+            std::string source_mem_name = source_memory_element.getName();
+            // Объединяем деревья сначала
+            output() << "Starting merge process..." << std::endl;
+            mergeTrees(current_tree, source_tree);
+            // Теперь создаем связь после объединения
+            TreeElement source_mem_now = current_tree->findElement(source_mem_name);
+            if (!source_mem_now) {
+                output() << "Error: Source memory not found after merge" << std::endl;
+                has_error_ = true;
+                return;
+            }
+            output() << "Creating connection: " << var_name
+                      << " -> " << source_mem_name << std::endl;
+            // TO: source memory, FROM: target
+            linkElements(current_tree, var_name, target_element.getPosition(),
+                                                       source_mem_name, source_mem_now.getPosition(), clause_id);
+            output() << "Connection created: " << var_name
+                      << " -> " << source_mem_name << std::endl;
+            // ПРОВЕРЯЕМ, что связь сохранилась после объединения (теперь не нужна, но для отладки)
+            if (current_tree->containsConnection(var_name, source_mem_name)) {
+                output() << "Connection verified after merge: " << var_name
+                          << " -> " << source_mem_name << std::endl;
+            } else {
+                output() << "ERROR: Connection lost after merge!" << std::endl;
+            }
+        } else {
+            output() << "Error: Source tree '" << nested_var_name << "' not found" << std::endl;
+            has_error_ = true;
+            return;
+        }
+    }
+    // Обрабатываем поле, если оно есть
+    if (value.field_kind != TraceValue::NoField) {
+        std::string current_name = nested_var_name;
+        processValueField(value, current_tree, current_name, 1);
+    }
+}
+// Вспомогательный метод для поиска элемента памяти в дереве
+TreeElement TraceAnalyzer::findMemoryElement(Tree* tree)
+{
+    if (!tree) return TreeElement();
+    const Tree::ElementRange elements = tree->getElements();
+    output() << "Looking for memory element in tree: " << tree->getName() << std::endl;
+    for (const TreeElement& element : elements) {
+        if (element.isMemory()) {
+            output() << "Found memory element: " << element.getName() << std::endl;
+            return element;
+        }
+    }
+    // Если не нашли MEMORY, возвращаем первый не-корневой элемент
+    std::string root_name = tree->getName();
+    for (const TreeElement& element : elements) {
+        if (element.getName() != root_name) {
+            output() << "Using non-root element as memory: " << element.getName() << std::endl;
+            return element;
+        }
+    }
+    output() << "No suitable memory element found" << std::endl;
+    return TreeElement();
+}
+void TraceAnalyzer::processValueField(const TraceValue& value,
+                                    Tree* current_tree,
+                                    std::string& last_name,
+                                    int nesting_level)
+{
+    if (value.field_kind == TraceValue::InvalidField) {
+        has_error_ = true;
+        return;
+    }
+    if (value.field_kind == TraceValue::DirectedField) {
+        // Рекурсивно переходим по полям (только по существующим элементам)
+        for (int i = 0; i < nesting_level; ++i) {
+            std::string target_name = navigateByField(current_tree, last_name, value.field_dir, value.field_direction, -1);
+            if (target_name.empty()) {
+                output() << "Error: Failed to navigate in processValueField at level " << i << std::endl;
+                has_error_ = true;
+                return;
+            }
+            last_name = target_name;
+            output() << "Recursive navigation level " << i << ": now at " << last_name << std::endl;
+        }
+    }
+}
+void TraceAnalyzer::handleMemoryAllocation(Tree* current_tree, const std::string& var_name, int clause_id, const std::string& operation_type)
+{
+    TreeElement element = current_tree->findElement(var_name);
+    if (!element) {
+        has_error_ = true;
+        output() << "Error: Element '" << var_name << "' not found for "
+                  << operation_type << std::endl;
+        return;
+    }
+    output() << "Executing " << operation_type << " for: " << var_name << std::endl;
+    // 1. Проверяем и удаляем связь с корнем, если она существует
+    removeRootLinkClauses(current_tree, current_tree->getName(), var_name);
+    // Удаление предыдущей связи
+    current_tree->removeConnectionsFrom(var_name, [&](const Connection& prev) {
+        output() << "Removed previous assignment: " << var_name << " -> " << prev.getTo() << std::endl;
+    });
+    // Сверх лимита сводки выделение сливается с уже существующим узлом своего места
+    if (site_summary_limit_ > 0 && foldAllocation(current_tree, var_name, element, clause_id, operation_type)) {
+        return;
+    }
+    // 2. Создаем memory variable
+    std::string mem_name = "N" + std::to_string(memory_var_index_++);
+    TreeElement mem_element = current_tree->addElement(mem_name, TreeElement::MEMORY, acquirePosition());
+    if (site_summary_limit_ > 0) {
+        summary_nodes_[mem_name] = {clause_id, 1};
+        site_nodes_[clause_id].push_back(mem_name);
+    }
+    // УДАЛЯЕМ СВЯЗИ С КОРНЕМ для новой memory variable
+    removeRootLinkClauses(current_tree, current_tree->getName(), mem_name);
+    // Создаем соединение: var_name -> mem_name
+    // TO: mem_name (положительный), FROM: var_name (отрицательный)
+    linkElements(current_tree, var_name, element.getPosition(),
+                                               mem_name, mem_element.getPosition(), clause_id);
+    // 3. Поля left/right создаются лениво (materializeFields). До первого обращения
+    // их заменяет связь mem_name -> root: цепочки mem -> left -> root и
+    // mem -> right -> root дают в КНФ ту же импликацию mem -> root
+    TreeElement root_element = current_tree->getRoot();
+    if (root_element) {
+        linkElements(current_tree, mem_name, mem_element.getPosition(),
+                                                   current_tree->getName(), root_element.getPosition(), clause_id);
+    }
+    output() << operation_type << ": " << var_name << " -> " << mem_name
+              << " (fields created on first access)"
+              << " at position " << clause_id << std::endl;
+    // Особые случаи для разных типов операций
+    if (operation_type == "calloc") {
+        output() << "Note: calloc operation - memory initialized to zero" << std::endl;
+    } else if (operation_type == "realloc") {
+        output() << "Note: realloc operation - previous memory block should be freed" << std::endl;
+    } else if (operation_type == "new[]") {
+        output() << "Note: new[] operation - array allocation, requires delete[]" << std::endl;
+    }
+}
+
+bool TraceAnalyzer::foldAllocation(Tree* tree, const std::string& var_name, const TreeElement& element,
+                                   int clause_id, const std::string& operation_type)
+{
+    auto site = site_nodes_.find(clause_id);
+    if (site == site_nodes_.end()) {
+        return false;
+    }
+    // Узлы места в этом дереве: на них кто-то ссылается (кроме корня) или они потеряны
+    TreeElement root_element = tree->getRoot();
+    TreeElement referenced_node;
+    TreeElement lost_node;
+    int referenced_blocks = 0;
+    int live_nodes = 0;
+    bool has_witness = false;
+    for (const std::string& name : site->second) {
+        TreeElement node = tree->findElement(name);
+        auto summary = summary_nodes_.find(name);
+        if (!node || !node.isMemory() || summary == summary_nodes_.end()) {
+            continue;   // Узел в другом дереве
+        }
+        if (summary->second.blocks == 0) {
+            has_witness = true;
+            continue;
+        }
+        ++live_nodes;
+        bool referenced = false;
+        for (const Connection& conn : tree->getConnectionsTo(name)) {
+            if (conn.getFromElement() != root_element) {
+                referenced = true;
+                break;
+            }
+        }
+        // Блоки распределяются по достижимым узлам равномерно
+        if (referenced && (!referenced_node || summary->second.blocks < referenced_blocks)) {
+            referenced_node = node;
+            referenced_blocks = summary->second.blocks;
+        } else if (!referenced && !lost_node) {
+            lost_node = node;
+        }
+    }
+    if (live_nodes < site_summary_limit_) {
+        return false;
+    }
+    TreeElement target = referenced_node;
+    if (!target) {
+        // Все узлы места потеряны: утечка уже видна в дереве. Слияние с потерянным узлом
+        // сделало бы его достижимым, поэтому один из них остается свидетелем утечки
+        if (!has_witness) {
+            summary_nodes_[lost_node.getName()].blocks = 0;
+            output() << "Summary node " << lost_node.getName() << " kept as leak witness for site "
+                      << clause_id << std::endl;
+            return false;
+        }
+        target = lost_node;
+    }
+    const std::string target_name = target.getName();
+    SummaryNode& summary = summary_nodes_[target_name];
+    summary.blocks++;
+    linkElements(tree, var_name, element.getPosition(), target_name, target.getPosition(), clause_id);
+    output() << operation_type << ": " << var_name << " -> " << target_name
+              << " (summary of site " << clause_id << ", " << summary.blocks << " blocks)" << std::endl;
+    return true;
+}
+
+void TraceAnalyzer::forgetSummaryNode(const std::string& name)
+{
+    auto summary = summary_nodes_.find(name);
+    if (summary == summary_nodes_.end()) {
+        return;
+    }
+    std::vector<std::string>& nodes = site_nodes_[summary->second.site];
+    nodes.erase(std::remove(nodes.begin(), nodes.end(), name), nodes.end());
+    if (nodes.empty()) {
+        site_nodes_.erase(summary->second.site);
+    }
+    summary_nodes_.erase(summary);
+}
+
+bool TraceAnalyzer::hasFieldElements(const Tree* tree, const TreeElement& memory) const
+{
+    for (const Connection& conn : tree->getConnectionsFrom(memory.getName())) {
+        TreeElement child = conn.getToElement();
+        if (child.isLeftVariable() || child.isRightVariable()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TraceAnalyzer::materializeFields(Tree* tree, const TreeElement& memory, int clause_id)
+{
+    // Имя копируется: добавление элементов может переместить хранилище имен
+    const std::string mem_name = memory.getName();
+    const int mem_position = memory.getPosition();
+    TreeElement root_element = tree->getRoot();
+    // Неявное состояние полей — связь памяти с корнем; она несет номер клаузы выделения
+    if (root_element) {
+        Connection implicit_link = tree->findConnection(mem_name, tree->getName());
+        if (implicit_link) {
+            clause_id = implicit_link.getPosition();
+            tree->removeConnection(mem_name, tree->getName());
+        }
+    }
+    // Создаем два элемента с соответствующими типами
+    std::string left_child_name = "N" + std::to_string(memory_var_index_++);
+    std::string right_child_name = "N" + std::to_string(memory_var_index_++);
+    TreeElement left_child = tree->addElement(left_child_name, TreeElement::LEFT_VARIABLE, acquirePosition());
+    TreeElement right_child = tree->addElement(right_child_name, TreeElement::RIGHT_VARIABLE, acquirePosition());
+    // Связи: mem_name -> left_child и mem_name -> right_child
+    linkElements(tree, mem_name, mem_position, left_child_name, left_child.getPosition(), clause_id);
+    linkElements(tree, mem_name, mem_position, right_child_name, right_child.getPosition(), clause_id);
+    // Связи: left_child -> root и right_child -> root
+    if (root_element) {
+        linkElements(tree, left_child_name, left_child.getPosition(),
+                     tree->getName(), root_element.getPosition(), clause_id);
+        linkElements(tree, right_child_name, right_child.getPosition(),
+                     tree->getName(), root_element.getPosition(), clause_id);
+    }
+    output() << "Materialized fields of " << mem_name
+              << ": left: " << left_child_name
+              << ", right: " << right_child_name
+              << " at position " << clause_id << std::endl;
+}
+
+void TraceAnalyzer::handleFree(Tree* current_tree, const std::string& var_name)
+{
+    TreeElement element = current_tree->findElement(var_name);
+    if (!element) {
+        has_error_ = true;
+        output() << "Error: Element '" << var_name << "' not found for free operation" << std::endl;
+        return;
+    }
+
+    output() << "Free operation: " << var_name << std::endl;
+
+    removeRootLinkClauses(current_tree, current_tree->getName(), var_name);
+
+    // Неявные поля памяти держатся на связи с корнем. Если освобождается сам корень,
+    // поля создаются до удаления входящих связей: иначе потерянная память выпадет из КНФ
+    if (element == current_tree->getRoot()) {
+        std::vector<TreeElement>& unmaterialized = free_children_;
+        unmaterialized.clear();
+        for (const Connection& conn : current_tree->getConnectionsTo(var_name)) {
+            TreeElement source_element = conn.getFromElement();
+            // Собственная память переменной удаляется вместе с ней
+            if (source_element.isMemory() && !hasFieldElements(current_tree, source_element)
+                && !current_tree->containsConnection(var_name, source_element.getName())) {
+                unmaterialized.push_back(source_element);
+            }
+        }
+        for (const TreeElement& memory : unmaterialized) {
+            materializeFields(current_tree, memory, -1);
+        }
+    }
+
+    // Снимок собственных соединений переменной: они удаляются после памяти и потомков.
+    // Буфер переиспользуется между строками, поэтому снимок не выделяет память
+    std::vector<Connection>& snapshot = free_snapshot_;
+    snapshot.clear();
+    for (const Connection& conn : current_tree->getConnectionsFrom(var_name)) {
+        snapshot.push_back(conn);
+    }
+    const size_t outgoing_count = snapshot.size();
+    for (const Connection& conn : current_tree->getConnectionsTo(var_name)) {
+        snapshot.push_back(conn);
+    }
+
+    output() << "  Removing " << outgoing_count << " outgoing connections" << std::endl;
+    output() << "  Removing " << snapshot.size() - outgoing_count << " incoming connections" << std::endl;
+
+    TreeElement memory_element;
+    for (size_t i = 0; i < outgoing_count; ++i) {
+        TreeElement target_element = snapshot[i].getToElement();
+        if (target_element.isMemory()) {
+            memory_element = target_element;
+            break;
+        }
+    }
+
+    auto summary = memory_element ? summary_nodes_.find(memory_element.getName()) : summary_nodes_.end();
+    if (summary != summary_nodes_.end() && summary->second.blocks > 1) {
+        // Узел сводки представляет несколько блоков: освобождается один из них,
+        // сам узел остается, снимается только ссылка переменной
+        summary->second.blocks--;
+        output() << "  Summary node " << memory_element.getName() << " still holds "
+                  << summary->second.blocks << " blocks" << std::endl;
+    } else if (memory_element) {
+        const std::string memory_name = memory_element.getName();
+        output() << "  Found memory element: " << memory_name << std::endl;
+
+        std::vector<TreeElement>& children = free_children_;
+        children.clear();
+        for (const Connection& mem_conn : current_tree->getConnectionsFrom(memory_name)) {
+            TreeElement child_element = mem_conn.getToElement();
+            if (child_element.isLeftVariable() || child_element.isRightVariable()) {
+                children.push_back(child_element);
+                output() << "    Found child element to remove: " << child_element.getName() << std::endl;
+            }
+        }
+
+        current_tree->removeConnectionsFrom(memory_name, [&](const Connection& mem_conn) {
+            output() << "    Removed memory connection: " << mem_conn.getFrom()
+                      << " -> " << mem_conn.getTo() << std::endl;
+        });
+
+        auto ignore = [](const Connection&) {};
+        for (const TreeElement& child : children) {
+            const std::string& child_name = child.getName();
+            removeRootLinkClauses(current_tree, current_tree->getName(), child_name);
+            current_tree->removeConnectionsFrom(child_name, ignore);
+            current_tree->removeConnectionsTo(child_name, ignore);
+            current_tree->removeElement(child_name);
+            output() << "    Removed child element: " << child_name << std::endl;
+        }
+
+        current_tree->removeElement(memory_name);
+        forgetSummaryNode(memory_name);
+        output() << "    Removed memory element: " << memory_name << std::endl;
+    } else {
+        output() << "  No memory element found for: " << var_name << std::endl;
+    }
+
+    // Имена концов снимка остаются читаемыми: новых элементов с момента снимка не было
+    for (const Connection& conn : snapshot) {
+        current_tree->removeConnection(conn.getFrom(), conn.getTo());
+        output() << "    Removed connection: " << conn.getFrom()
+                  << " -> " << conn.getTo() << std::endl;
+    }
+
+    if (element != current_tree->getRoot()) {
+        current_tree->removeElement(var_name);
+        output() << "  Removed element: " << var_name << std::endl;
+    } else {
+        output() << "  Skipped removal of root element: " << var_name << std::endl;
+    }
+
+    output() << "Free completed for: " << var_name << std::endl;
+}
+
+TreeSolution TraceAnalyzer::solveTree(Tree* tree, bool want_model)
+{
+    if (!tree) return TreeSolution(TreeSolution::NoLeak);
+    // ЕСЛИ ДЕРЕВО ПУСТОЕ (все элементы освобождены) - УТЕЧКИ НЕТ
+    if (tree->getElementCount() == 0 && tree->getConnectionCount() == 0) {
+        output() << "Tree is empty (all memory freed) - no memory leak" << std::endl;
+        solver_stats_.addSkip(SolverStats::EmptyTree);
+        return TreeSolution(TreeSolution::NoLeak);
+    }
+    const std::vector<ConnectionRecord>& connections = tree->getConnectionRecords();
+    // ЕСЛИ НЕТ СОЕДИНЕНИЙ, НО ЕСТЬ ЭЛЕМЕНТЫ - ЭТО УТЕЧКА
+    if (connections.size() == 0 && tree->getElementCount() > 0) {
+        output() << "No connections but elements exist - potential memory leak" << std::endl;
+        solver_stats_.addSkip(SolverStats::NoConnections);
+        return TreeSolution(TreeSolution::Leak);
+    }
+    // Локальная нумерация DIMACS: переменные 1..n заводятся только для позиций,
+    // встречающихся в соединениях дерева, за один проход
+    CnfFormula formula;
+    std::unordered_map<int, int> local_vars;    // глобальная позиция -> переменная формулы
+    TreeSolution solution;
+    std::vector<int>& global_positions = solution.global_positions_; // переменная формулы - 1 -> глобальная позиция
+    auto localVar = [&](int position) {
+        auto it = local_vars.find(position);
+        if (it != local_vars.end()) {
+            return it->second;
+        }
+        global_positions.push_back(position);
+        int var = static_cast<int>(global_positions.size());
+        local_vars.emplace(position, var);
+        return var;
+    };
+    // Преобразуем соединения в клаузы одним проходом по плоскому массиву записей
+    formula.clauses.reserve(connections.size() + 2, connections.size() * 2);
+    for (const ConnectionRecord& conn : connections) {
+        int clause[2];
+        size_t count = 0;
+        if (conn.positive >= 0) {
+            clause[count++] = localVar(conn.positive);  // Положительный литерал
+        }
+        if (conn.negative >= 0) {
+            clause[count++] = -localVar(conn.negative); // Отрицательный литерал
+        }
+        if (count > 0) {
+            formula.addClause(clause, count);
+        }
+    }
+    size_t totalVariables = global_positions.size();
+    // ЕСЛИ НЕТ ПЕРЕМЕННЫХ - УТЕЧКИ НЕТ
+    if (totalVariables == 0) {
+        output() << "No variables in CNF - no memory leak" << std::endl;
+        solver_stats_.addSkip(SolverStats::NoVariables);
+        return TreeSolution(TreeSolution::NoLeak);
+    }
+    // Добавляем клаузу с положительными литералами всех переменных (x10 ∨ x11 ∨ x12 ∨ x13)
+    // и клаузу с отрицательными литералами (¬x10 ∨ ¬x11 ∨ ¬x12 ∨ ¬x13).
+    // Все переменные уже встречались в клаузах, num_vars не меняется
+    formula.clauses.reserve(formula.clauses.size() + 2, formula.clauses.literalCount() + 2 * totalVariables);
+    for (int var = 1; var <= static_cast<int>(totalVariables); ++var) {
+        formula.clauses.addLiteral(var);  // x_i
+    }
+    formula.clauses.closeClause();
+    for (int var = 1; var <= static_cast<int>(totalVariables); ++var) {
+        formula.clauses.addLiteral(-var); // ¬x_i
+    }
+    formula.clauses.closeClause();
+    if (!dimacs_dump_dir_.empty()) {
+        dumpDimacs(tree, formula);
+    }
+    // Решаем КНФ: большие деревья — портфелем решателей в параллельных потоках
+    SolverBackend* solver = solver_;
+    if (portfolio_ && connections.size() >= static_cast<size_t>(portfolio_threshold_)) {
+        solver = portfolio_;
+    }
+    // Модель извлекается только по запросу: для вердикта она не нужна
+    // Вердикт без модели можно взять из общего кэша; модель есть только у решателя
+    SolveResult result = SolveResult::Unknown;
+    bool cached = solve_cache_ && !want_model && solve_cache_->lookup(formula, result);
+    bool timed_out = false;
+    if (!cached) {
+        // Срок решения — ближайший из лимита решения и лимита трассы
+        const bool watched = solve_timeout_ms_ > 0 || trace_time_limit_ms_ > 0;
+        if (watched) {
+            SolveWatchdog::Clock::time_point deadline = trace_time_limit_ms_ > 0
+                ? trace_deadline_ : SolveWatchdog::Clock::time_point::max();
+            if (solve_timeout_ms_ > 0) {
+                deadline = std::min(deadline, SolveWatchdog::Clock::now()
+                                                  + std::chrono::milliseconds(solve_timeout_ms_));
+            }
+            watchdog_.arm(solver, deadline);
+        }
+        const std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+        result = solver->solve(formula, want_model ? &solution.model_ : nullptr);
+        timed_out = watched && watchdog_.disarm();
+        solver_stats_.addSolve(connections.size(), formula, solver->lastStats(),
+                               std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count(),
+                               result);
+        if (solve_cache_ && result != SolveResult::Unknown) {
+            solve_cache_->store(formula, result);
+        }
+    } else {
+        solver_stats_.addSkip(SolverStats::CacheHit);
+    }
+    if (result == SolveResult::Unknown && (timed_out || solver->budgetExhausted())) {
+        output() << "UNKNOWN - solver '" << solver->name() << "' stopped by "
+                  << (timed_out ? "time limit" : "search budget") << " for tree '"
+                  << tree->getName() << "' - verdict unknown" << std::endl;
+        return TreeSolution(TreeSolution::Unknown);
+    }
+    if (result == SolveResult::Unknown) {
+        output() << "Error: Solver '" << solver->name() << "' failed for tree '"
+                  << tree->getName() << "': " << solver->lastError() << std::endl;
+        has_error_ = true;
+        return TreeSolution(TreeSolution::Failed);
+    }
+    if (!cached && solver == portfolio_) {
+        output() << "Portfolio answer from: " << portfolio_->lastWinner() << std::endl;
+    }
+    solution.tree_generation_ = tree->getGeneration();
+    if (result == SolveResult::Sat) { // Утечка, если КНФ разрешима (SAT)
+        solution.verdict_ = TreeSolution::Leak;
+        output() << "SAT - solution found for tree '" << tree->getName() << "' - MEMORY LEAK DETECTED" << std::endl;
+    } else {
+        solution.verdict_ = TreeSolution::NoLeak;
+        solution.model_.clear();
+        output() << "UNSAT - no solution found for tree '" << tree->getName() << "' - NO memory leak" << std::endl;
+    }
+    return solution;
+}
+
+TreeSolution::Verdict TraceAnalyzer::solveCNF(Tree* tree)
+{
+    TreeSolution solution = solveTree(tree, show_model_);
+    if (solution.hasLeak() && show_model_) {
+        // Имена переменных нужны только для вывода модели
+        for (const TreeSolution::Assignment& assignment : solution.assignments(*tree)) {
+            output() << assignment.name << " (x" << assignment.position << ") = "
+                      << (assignment.value ? "true" : "false") << std::endl;
+        }
+    }
+    return solution.verdict();
+}
+bool TraceAnalyzer::setSolverBackend(const std::string& spec)
+{
+    std::string error;
+    SolverBackend* solver = SolverBackend::create(spec, error);
+    if (!solver) {
+        output() << "Error: " << error << std::endl;
+        return false;
+    }
+    delete solver_;
+    solver_ = solver;
+    solver_->setBudget(solve_budget_);
+    return true;
+}
+bool TraceAnalyzer::setPortfolio(const std::string& members, int min_connections)
+{
+    std::string error;
+    PortfolioBackend* portfolio = PortfolioBackend::create(members, error);
+    if (!portfolio) {
+        output() << "Error: " << error << std::endl;
+        return false;
+    }
+    delete portfolio_;
+    portfolio_ = portfolio;
+    portfolio_->setBudget(solve_budget_);
+    portfolio_threshold_ = min_connections;
+    return true;
+}
+void TraceAnalyzer::setMemoryBudget(size_t bytes, const std::string& spill_path)
+{
+    treeManager_->setMemoryBudget(bytes, spill_path);
+}
+void TraceAnalyzer::setSolveBudget(const SolveBudget& budget)
+{
+    solve_budget_ = budget;
+    solver_->setBudget(budget);
+    if (portfolio_) {
+        portfolio_->setBudget(budget);
+    }
+}
+void TraceAnalyzer::dumpDimacs(Tree* tree, const CnfFormula& formula)
+{
+    // Имя файла: <дерево>_<порядковый номер решения>.cnf
+    std::string file_path = dimacs_dump_dir_ + "/" + tree->getName() + "_"
+                        + std::to_string(dimacs_dump_count_++) + ".cnf";
+    std::ostringstream text;
+    writeDimacs(text, formula, "tree " + tree->getName());
+    std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        output() << "Warning: Failed to write DIMACS file: " << file_path << std::endl;
+        return;
+    }
+    file << text.str();
+}
+void TraceAnalyzer::mergeTrees(Tree* target_tree, Tree* source_tree)
+{
+    if (!target_tree || !source_tree || target_tree == source_tree) {
+        return;
+    }
+    output() << "Merging tree '" << source_tree->getName()
+              << "' into '" << target_tree->getName() << "'" << std::endl;
+    TreeElement target_root = target_tree->getRoot();
+    if (!target_root) {
+        output() << "Error: Target tree has no root" << std::endl;
+        return;
+    }
+    std::string source_root_name = source_tree->getName();
+    // 1. УДАЛЯЕМ СВЯЗИ ЛИСТЬЕВ source дерева с ИХ корнем
+    source_tree->removeConnectionsTo(source_root_name, [&](const Connection& conn) {
+        output() << "Removing leaf-to-source-root connection: "
+                  << conn.getFrom() << " -> " << conn.getTo() << std::endl;
+    });
+    // 2. Копируем элементы из source в target (кроме корня source)
+    for (const TreeElement& element : source_tree->getElements()) {
+        if (element.getName() == source_root_name) {
+            continue; // Пропускаем корень source дерева
+        }
+        // Проверяем, не существует ли уже элемент с таким именем
+        if (!target_tree->containsElement(element.getName())) {
+            target_tree->addElement(element);
+            output() << " Copied element: " << element.getName() << std::endl;
+        } else {
+            output() << " Element already exists: " << element.getName() << std::endl;
+        }
+    }
+    // 3. Копируем соединения (кроме тех, что связаны с корнем source)
+    for (const Connection& conn : source_tree->getConnections()) {
+        if (conn.getFrom() != source_root_name && conn.getTo() != source_root_name) {
+            // Проверяем, не существует ли уже такое соединение
+            if (!target_tree->containsConnection(conn.getFrom(), conn.getTo())) {
+                target_tree->addConnection(conn);
+                output() << " Copied connection: " << conn.getFrom()
+                          << " -> " << conn.getTo() << std::endl;
+            } else {
+                output() << " Connection already exists: " << conn.getFrom()
+                          << " -> " << conn.getTo() << std::endl;
+            }
+        }
+    }
+    // 4. НАХОДИМ ЛИСТЬЯ source дерева и добавляем связи к корню TARGET дерева
+    const Tree::ElementRange source_leaves = findLeaves(source_tree);
+    output() << " Found " << source_leaves.size() << " leaves in source tree: ";
+    for (const TreeElement& leaf : source_leaves) {
+        output() << leaf.getName() << " ";
+    }
+    output() << std::endl;
+    for (const TreeElement& leaf : source_leaves) {
+        const std::string& leaf_name = leaf.getName();
+        TreeElement leaf_element = target_tree->findElement(leaf_name);
+        if (leaf_element) {
+            // Создаем связь от листа source дерева к корню TARGET дерева
+            // TO: target root - положительный, FROM: leaf - отрицательный
+            linkElements(target_tree, leaf_name, leaf_element.getPosition(),
+                                                      target_tree->getName(), target_root.getPosition(), -1);
+            output() << " Added leaf-to-target-root connection: " << leaf_name
+                      << " -> " << target_tree->getName() << std::endl;
+        }
+    }
+    // 6. Удаляем source tree из менеджера; его корень не копировался, позиция свободна
+    if (source_tree->getRoot()) {
+        positions_.release(source_tree->getRoot().getPosition());
+    }
+    treeManager_->removeTree(source_root_name);
+    output() << "Successfully merged trees" << std::endl;
+}
+// Вспомогательный метод для поиска элементов, которые имеют связь с корнем
+Tree::ElementRange TraceAnalyzer::findElementsWithRootConnection(const Tree* tree)
+{
+    // Множество элементов, связанных с корнем, дерево ведет инкрементально: обход и
+    // размер не зависят от числа остальных элементов
+    const Tree::ElementRange elements = tree->getRootLinkedElements();
+    output() << " Elements with root connection in tree '" << tree->getName() << "': ";
+    for (const TreeElement& element : elements) {
+        output() << element.getName() << " ";
+    }
+    output() << std::endl;
+    return elements;
+}
+// Вспомогательный метод для поиска листьев в дереве
+Tree::ElementRange TraceAnalyzer::findLeaves(const Tree* tree)
+{
+    // Листья - это элементы без исходящих соединений (множество листьев ведет само дерево,
+    // размер диапазона — O(1))
+    const Tree::ElementRange leaves = tree->getLeaves();
+    for (const TreeElement& leaf : leaves) {
+        output() << " Leaf found: " << leaf.getName() << std::endl;
+    }
+    return leaves;
+}
+int TraceAnalyzer::acquirePosition()
+{
+    return positions_.acquire();
+}
+void TraceAnalyzer::linkElements(Tree* tree, const std::string& from, int from_position,
+                                 const std::string& to, int to_position, int clause_id) const
+{
+    // TO - положительный литерал, FROM - отрицательный
+    tree->addConnection(from, to, to_position, from_position, clause_id);
+}
+void TraceAnalyzer::compactPositions()
+{
+    // Собираем живые позиции всех деревьев
+    const std::map<std::string, Tree*>& all_trees = treeManager_->getAllTrees();
+    std::vector<int> live_positions;
+    for (const auto& tree_entry : all_trees) {
+        const Tree* tree = loadTree(tree_entry.first);
+        if (!tree) {
+            return;
+        }
+        for (const TreeElement& element : tree->getElements()) {
+            live_positions.push_back(element.getPosition());
+        }
+        treeManager_->trimToBudget(current_tree_);
+    }
+    std::sort(live_positions.begin(), live_positions.end());
+    // Плотная нумерация с сохранением относительного порядка
+    std::unordered_map<int, int> mapping;
+    int next_position = 0;
+    for (int position : live_positions) {
+        if (mapping.emplace(position, next_position).second) {
+            ++next_position;
+        }
+    }
+    output() << "Compacting positions: " << positions_.highWater()
+              << " -> " << next_position << std::endl;
+    for (const auto& tree_entry : all_trees) {
+        Tree* tree = loadTree(tree_entry.first);
+        if (!tree) {
+            return;
+        }
+        tree->remapPositions(mapping);
+        treeManager_->trimToBudget(current_tree_);
+    }
+    positions_.reset(next_position);
+}
+TreeElement TraceAnalyzer::findOrCreateElement(Tree* tree, const std::string& name, const std::string& type)
+{
+    TreeElement element = tree->findElement(name);
+    if (!element) {
+        // Перед созданием проверяем и удаляем возможные связи с корнем
+        removeRootLinkClauses(tree, tree->getName(), name);
+        int type_code;
+        if (type == "Variable") {
+            type_code = TreeElement::ROOT; // Основные переменные становятся корнями
+        } else if (type == "Memory") {
+            type_code = TreeElement::MEMORY;
+        } else {
+            type_code = TreeElement::ROOT; // По умолчанию
+        }
+        element = tree->addElement(name, type_code, acquirePosition());
+            output() << "Created element: " << name << " type: " << element.getTypeName() << std::endl;
+    }
+    return element;
+}
+void TraceAnalyzer::printElements() const
+{
+    const std::map<std::string, Tree*>& all_trees = treeManager_->getAllTrees();
+    for (auto it = all_trees.begin(); it != all_trees.end(); ++it) {
+        Tree* tree = treeManager_->getTree(it->first);
+        if (!tree) {
+            output() << "Error: " << treeManager_->errorString() << std::endl;
+            break;
+        }
+        output() << "=== Tree: " << tree->getName() << " ===" << std::endl;
+        for (const TreeElement& element : tree->getElements()) {
+            output() << "Element: " << element.getName()
+                      << " Type: " << element.getType()
+                      << " Position: " << element.getPosition()
+                      << std::endl;
+        }
+        for (const Connection& conn : tree->getConnections()) {
+            output() << "Connection: " << conn.getFrom()
+                      << " -> " << conn.getTo()
+                      << std::endl;
+        }
+        output() << "------------------------" << std::endl;
+        treeManager_->trimToBudget(current_tree_);
+    }
+    // ВЫВОДИТЬ РЕЗУЛЬТАТ АНАЛИЗА, НО НЕ УСТАНАВЛИВАТЬ ФЛАГ
+    if (has_memory_leak_) {
+        output() << "WARNING: Memory leaks detected!" << std::endl;
+    } else {
+        output() << "No memory leaks detected." << std::endl;
+    }
+}
+
+void TraceAnalyzer::handleNullAssignment(Tree* current_tree, const std::string& var_name, int clause_id)
+{
+    TreeElement element = current_tree->findElement(var_name);
+    if (!element) {
+        has_error_ = true;
+        output() << "Error: Element '" << var_name << "' not found for Null assignment" << std::endl;
+        return;
+    }
+
+    output() << "Executing Null assignment for: " << var_name << std::endl;
+
+    removeRootLinkClauses(current_tree, current_tree->getName(), var_name);
+
+    std::string null_name = "N" + std::to_string(memory_var_index_++);
+    TreeElement null_element = current_tree->addElement(null_name, TreeElement::NULL_ELEMENT, acquirePosition());
+
+    removeRootLinkClauses(current_tree, current_tree->getName(), null_name);
+
+    linkElements(current_tree, var_name, element.getPosition(),
+                                               null_name, null_element.getPosition(), clause_id);
+
+    TreeElement root_element = current_tree->getRoot();
+    if (root_element) {
+        linkElements(current_tree, null_name, null_element.getPosition(),
+                                                   current_tree->getName(), root_element.getPosition(), clause_id);
+    }
+
+    output() << "Null assignment: " << var_name << " -> " << null_name
+              << " at position " << clause_id << std::endl;
+}
+
+// Заглушки для методов, которые требуют дополнительной реализации
+void TraceAnalyzer::removeRootLinkClauses(Tree* tree, const std::string& root_name, const std::string& var_name)
+{
+    if (!tree) return;
+    TreeElement root_element = tree->getRoot();
+    TreeElement var_element = tree->findElement(var_name);
+    if (!root_element || !var_element) return;
+    output() << "Checking root connections for: " << var_name << std::endl;
+    bool found_connections = false;
+    // Проверка по индексу дерева: без связи с корнем сканировать соединения не нужно
+    if (tree->hasConnectionToRoot(var_name)) {
+        // Удаляем соединение от корня к переменной
+        if (tree->removeConnection(root_name, var_name)) {
+            output() << "Removed root connection: " << root_name
+                      << " -> " << var_name << std::endl;
+            found_connections = true;
+        }
+        // Удаляем соединение от переменной к корню
+        if (tree->removeConnection(var_name, root_name)) {
+            output() << "Removed root connection: " << var_name
+                      << " -> " << root_name << std::endl;
+            found_connections = true;
+        }
+    }
+    if (!found_connections) {
+        output() << "No root connections found for: " << var_name << std::endl;
+    }
+}
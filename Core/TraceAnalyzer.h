@@ -0,0 +1,327 @@
+#ifndef TRACEANALYZER_H
+#define TRACEANALYZER_H
+
+#include <iostream>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Tree.h"
+#include "TreeManager.h"
+#include "Connection.h"
+#include "PositionAllocator.h"
+#include "TraceRow.h"
+#include "TraceSource.h"
+#include "Checkpoint.h"
+#include "TreeSolution.h"
+#include "SolveCache.h"
+#include "SolverStats.h"
+#include "CNF/SolverBackend.h"
+#include "CNF/PortfolioBackend.h"
+#include "CNF/SolveWatchdog.h"
+
+// Ядро анализа трассы без зависимости от Qt: строит деревья, решает их формулы
+// и ведет отчет. Строки берутся из любого TraceSource
+class TraceAnalyzer
+{
+public:
+    TraceAnalyzer();
+    virtual ~TraceAnalyzer();
+
+    // Анализ строк источника; source_size — размер исходной трассы в байтах
+    // (сверяется с контрольной точкой при возобновлении, -1 если неизвестен)
+    bool analyze(TraceSource& source, int64_t source_size);
+    bool parseBinaryFile(const std::string& file_path);
+    static int64_t fileSize(const std::string& file_path);
+
+    // Сеанс без файла трассы: строки подаются из памяти по одной или пакетами,
+    // каждая анализируется сразу. analyze() работает через тот же сеанс
+    bool beginSession(int64_t source_size = -1);
+    bool pushRow(const TraceStatement& row);
+    bool pushRows(const std::vector<TraceStatement>& rows);
+    bool finishSession();                       // Финальный анализ всех деревьев
+    void abortSession() { session_active_ = false; }  // Закрыть без финального анализа
+    bool isSessionActive() const { return session_active_; }
+    // Вердикт дерева по последнему решению; up_to_date == false, если дерево
+    // менялось после него (строки с null не запускают решение) или еще не решалось
+    struct TreeVerdict {
+        std::string tree;
+        bool has_leak;
+        bool unknown;       // Решатель остановлен лимитом, ответа нет
+        bool up_to_date;
+    };
+    std::vector<TreeVerdict> currentVerdicts() const;
+
+    // Поток отчета анализа (по умолчанию std::cout); у каждого анализатора свой,
+    // поэтому несколько анализаторов могут работать параллельно
+    void setOutput(std::ostream& out) { out_ = &out; }
+    std::ostream& output() const { return *out_; }
+
+    // Общий кэш вердиктов формул (может разделяться несколькими анализаторами)
+    void setSolveCache(SolveCache* cache) { solve_cache_ = cache; }
+
+    // Получение результатов
+    TreeManager* getTreeManager() const { return treeManager_; }
+    bool hasError() const { return has_error_; }
+    bool hasMemoryLeak() const { return has_memory_leak_; }
+
+    // Остановка на первой утечке: после строки, на которой решатель нашел утечку,
+    // строки больше не принимаются, финальный анализ не выполняется
+    void setFailFast(bool enabled) { fail_fast_ = enabled; }
+    bool stoppedOnLeak() const { return stopped_on_leak_; }
+    int failFastRow() const { return fail_fast_row_; }
+    const std::string& failFastTree() const { return fail_fast_tree_; }
+    // Анализ остановлен досрочно: утечкой при остановке на первой утечке
+    // или лимитом времени трассы
+    bool isStopped() const { return stopped_on_leak_ || time_limit_exceeded_; }
+    bool timeLimitExceeded() const { return time_limit_exceeded_; }
+    // Число деревьев, чей последний вердикт неизвестен (решатель остановлен лимитом)
+    int unknownVerdictCount() const;
+
+    // Вспомогательные методы
+    void printElements() const;
+    TreeSolution::Verdict solveCNF(Tree* tree);
+    // Решить формулу дерева; модель сохраняется только при want_model
+    TreeSolution solveTree(Tree* tree, bool want_model);
+    // Печатать модель решателя для деревьев с утечкой
+    void setShowModel(bool enabled) { show_model_ = enabled; }
+
+    // Решатель КНФ: "minisat" (по умолчанию), "dpll" или "external:<команда>"
+    bool setSolverBackend(const std::string& spec);
+    std::string solverName() const { return solver_->name(); }
+    // Портфель решателей для больших деревьев: включается, когда число соединений
+    // дерева не меньше порога; меньшие деревья решаются одним решателем
+    bool setPortfolio(const std::string& members, int min_connections);
+    // Статистика решений за прогон (после возобновления — только с момента возобновления)
+    const SolverStats& solverStats() const { return solver_stats_; }
+    // Сохранять формулу каждого решаемого дерева в DIMACS-файл в каталоге
+    void setDimacsDumpDirectory(const std::string& directory) { dimacs_dump_dir_ = directory; }
+
+    // Лимиты решения: бюджет поиска и время одного решения (0 — без ограничения).
+    // Решение, упершееся в лимит, дает вердикт "неизвестно", анализ продолжается
+    void setSolveBudget(const SolveBudget& budget);
+    void setSolveTimeout(int milliseconds) { solve_timeout_ms_ = milliseconds > 0 ? milliseconds : 0; }
+    // Лимит времени всей трассы: по его истечении текущее решение прерывается,
+    // а анализ останавливается после текущей строки без финального анализа
+    void setTraceTimeLimit(int seconds) { trace_time_limit_ms_ = seconds > 0 ? int64_t(seconds) * 1000 : 0; }
+
+    // Уплотнение позиций: при сильной фрагментации живые позиции перенумеровываются подряд
+    void setPositionCompaction(bool enabled) { compact_positions_ = enabled; }
+    void compactPositions();
+
+    // Сводка по местам выделения: в дереве не больше limit узлов памяти на место
+    // (id строки), следующие выделения этого места сливаются с ними (0 — выключено)
+    void setSiteSummaryLimit(int limit) { site_summary_limit_ = limit > 0 ? limit : 0; }
+
+    // Бюджет памяти деревьев: между строками давно не менявшиеся деревья вытесняются
+    // в компактную форму (в память или в файл spill_path) и восстанавливаются при
+    // следующем обращении. 0 — без ограничения
+    void setMemoryBudget(size_t bytes, const std::string& spill_path = std::string());
+
+    // Конвейер: декодирование строк в отдельном потоке (по умолчанию включен)
+    void setPipelineEnabled(bool enabled) { pipeline_enabled_ = enabled; }
+    void setPipelineDepth(int rows) { pipeline_depth_ = rows > 0 ? rows : 1; }
+
+    // Контрольные точки: периодическая запись состояния и возобновление с нее
+    void enableCheckpoints(const std::string& path, int interval_seconds);
+    bool resumeFrom(const std::string& path);
+    bool writeCheckpoint();
+
+    // Отчет после каждой строки: полный (соединения и элементы всех деревьев)
+    // или только изменения строки (события деревьев и смена вердикта)
+    enum ReportMode {
+        FullReport = 0,
+        DeltaReport
+    };
+    void setReportMode(ReportMode mode) { report_mode_ = mode; }
+    // Полный вывод всех деревьев
+    void dumpAllTrees() const;
+    // Запросить полный вывод после текущей строки (можно вызывать из обработчика сигнала)
+    void requestFullDump() { full_dump_requested_.store(true); }
+
+protected:
+    // Основные структуры данных
+    TreeManager* treeManager_;
+    bool has_error_;
+    bool tree_error_reported_;      // Ошибка менеджера деревьев уже выведена
+    bool has_memory_leak_;
+    Tree* current_tree_;
+
+private:
+    // Временные переменные для парсинга
+    PositionAllocator positions_;
+    int memory_var_index_;
+    bool compact_positions_;
+
+    // Сводка по местам выделения
+    struct SummaryNode {
+        int site;                   // id строки выделения
+        int blocks;                 // Сколько блоков представляет узел; 0 — свидетель утечки
+    };
+    int site_summary_limit_;
+    std::unordered_map<std::string, SummaryNode> summary_nodes_;        // Имя узла памяти -> сводка
+    std::unordered_map<int, std::vector<std::string>> site_nodes_;      // Место -> узлы в порядке создания
+
+    // Остановка на первой утечке
+    bool fail_fast_;
+    bool stopped_on_leak_;
+    int fail_fast_row_;             // Строка с утечкой
+    std::string fail_fast_tree_;    // Первое дерево с утечкой в этой строке
+
+    // Функции трассы. Сводка — итог тела на графе указателей, вычисленный один раз
+    // пробным прогоном на отдельном дереве; вызов применяет его без повторного прогона.
+    // Имена в сводке — имена пробного дерева: параметры, локальные переменные,
+    // имя пробного корня и новые элементы (им при применении даются свежие имена)
+    struct SummaryLink {
+        std::string from;
+        std::string to;
+        int position;
+    };
+    struct FunctionSummary {
+        bool ready = false;                     // Сводка вычислялась
+        bool supported = false;                 // Тело не читает состояние вызывающего
+        std::string root;                       // Имя пробного корня
+        std::vector<std::string> variables;     // Именованные переменные тела
+        std::vector<std::string> assigned;      // Получают значение: сброс связей с корнем
+        std::vector<std::string> allocated;     // Получают память: сброс прежних соединений
+        std::vector<std::string> freed;         // Освобождаются телом
+        std::vector<std::pair<std::string, int>> elements; // Новые элементы: имя и тип
+        std::vector<SummaryLink> links;         // Соединения после тела
+    };
+    struct TraceFunction {
+        TraceStatement definition;
+        FunctionSummary summary;
+    };
+    std::unordered_map<std::string, TraceFunction> functions_;
+    int call_depth_;
+
+    // Контрольные точки
+    CheckpointStore* checkpoint_;
+    int64_t checkpoint_interval_ms_;
+    std::chrono::steady_clock::time_point checkpoint_started_;
+    int64_t rows_processed_;        // Обработано строк трассы (включая пропущенные при возобновлении)
+    int64_t resume_rows_;           // Сколько строк покрывает восстановленная контрольная точка
+    int64_t resume_source_size_;    // Размер трассы, для которой записана контрольная точка
+    int64_t source_size_;
+
+    // Конвейер декодирования
+    bool pipeline_enabled_;
+    int pipeline_depth_;            // Емкость буфера между декодером и анализом (строк)
+
+    // Решатель КНФ
+    SolverBackend* solver_;
+    PortfolioBackend* portfolio_;
+    int portfolio_threshold_;
+    std::string dimacs_dump_dir_;
+    SolveCache* solve_cache_;       // Не принадлежит анализатору
+    SolveBudget solve_budget_;
+    int solve_timeout_ms_;
+    int64_t trace_time_limit_ms_;
+    SolveWatchdog::Clock::time_point trace_deadline_;
+    bool time_limit_exceeded_;
+    SolveWatchdog watchdog_;
+    int dimacs_dump_count_;
+    SolverStats solver_stats_;
+    bool show_model_;               // Печатать модель для деревьев с утечкой
+
+    // Последние вердикты деревьев (для отчета об изменениях и currentVerdicts)
+    struct ReportedTree {
+        uint64_t generation;        // Поколение дерева при последнем решении
+        bool has_leak;
+        bool unknown;               // Решатель остановлен лимитом
+    };
+    ReportMode report_mode_;
+    std::unordered_map<std::string, ReportedTree> reported_trees_;
+    std::atomic<bool> full_dump_requested_;
+    bool session_active_;
+    std::ostream* out_;
+    // Буферы handleFree, переиспользуемые между строками
+    std::vector<Connection> free_snapshot_;
+    std::vector<TreeElement> free_children_;
+
+    // Вспомогательные методы парсинга
+    // Декодированная строка; непустая ошибка завершает разбор
+    struct DecodedRow {
+        TraceStatement statement;
+        std::string error;
+    };
+    // Источник строк: заполняет row и возвращает false, когда строки закончились
+    typedef std::function<bool(DecodedRow&)> RowSource;
+    bool analyzeRows(const RowSource& next_row);
+    bool consumeRow(const DecodedRow& row);
+    bool processRow(const TraceStatement& row);
+    void maybeWriteCheckpoint();
+    // Дерево менеджера (вытесненное восстанавливается). nullptr при ошибке
+    // восстановления: она выводится и прерывает строку
+    Tree* loadTree(const std::string& name);
+    void reportTreeManagerError();
+    void analyzeTreesAfterRow(int clause_id);
+    void analyzeAllTrees(int clause_id);
+    void analyzeChangedTrees(int clause_id);
+    // Запомнить строку и дерево утечки и остановить анализ (если включена остановка)
+    void stopOnLeak(const std::string& tree_name, int clause_id);
+    void printTreeState(const Tree* tree) const;
+    void printTreeEvent(const TreeEvent& event) const;
+    bool finishAnalysis();
+    void processBody(const std::vector<TraceStatement>& body, Tree* current_tree, int clause_id);
+    void processBranch(const std::vector<TraceStatement>& branch_body, Tree* current_tree, int clause_id);
+    void processOperation(const TraceStatement& op_statement, Tree* current_tree, int clause_id);
+    void processLoop(const TraceStatement& loop_statement, Tree* current_tree, int clause_id);
+    // Функции: определение, вызов, вычисление и применение сводки
+    void defineFunction(const TraceStatement& definition);
+    void processCall(const TraceStatement& call, Tree* current_tree, int clause_id);
+    bool collectEffects(const std::vector<TraceStatement>& body, FunctionSummary& summary,
+                        std::unordered_set<std::string>& allocated, std::unordered_set<std::string>& freed) const;
+    bool isSelfContainedField(const TraceField& field) const;
+    void computeSummary(TraceFunction& function, int clause_id);
+    bool applySummary(const TraceFunction& function, const TraceStatement& call, Tree* tree, int clause_id);
+    static void renameVariables(std::vector<TraceStatement>& body,
+                                const std::unordered_map<std::string, std::string>& names);
+    void processStructureField(const TraceField& field,
+                               Tree* current_tree,
+                               const std::string& var_name,
+                               int clause_id);
+    void processNestedValue(const TraceValue& value,
+                            Tree* current_tree,
+                            const std::string& var_name,
+                            int clause_id);
+    void processValueField(const TraceValue& value,
+                           Tree* current_tree,
+                           std::string& last_name,
+                           int nesting_level);
+
+    // Методы для работы с памятью
+    void handleMalloc(Tree* current_tree, const std::string& var_name, int clause_id);
+    void handleFree(Tree* current_tree, const std::string& var_name);
+    void handleNullAssignment(Tree* current_tree, const std::string& var_name, int clause_id);
+    // Методы для работы с деревьями
+    void mergeTrees(Tree* target_tree, Tree* source_tree);
+    Tree::ElementRange findLeaves(const Tree* tree);
+    Tree::ElementRange findElementsWithRootConnection(const Tree* tree);
+    TreeElement findMemoryElement(Tree* tree);
+    // Вспомогательные методы
+    int acquirePosition();
+    void linkElements(Tree* tree, const std::string& from, int from_position,
+                      const std::string& to, int to_position, int clause_id) const;
+    TreeElement findOrCreateElement(Tree* tree, const std::string& name, const std::string& type);
+    void handleMemoryAllocation(Tree* current_tree, const std::string& var_name, int clause_id, const std::string& operation_type);
+    // Слияние выделения с узлом сводки его места; false — нужен новый узел
+    bool foldAllocation(Tree* tree, const std::string& var_name, const TreeElement& element,
+                        int clause_id, const std::string& operation_type);
+    void forgetSummaryNode(const std::string& name);
+    // Создание полей left/right памяти при первом обращении к ним
+    bool hasFieldElements(const Tree* tree, const TreeElement& memory) const;
+    void materializeFields(Tree* tree, const TreeElement& memory, int clause_id);
+    // Методы для маршрутизации по полям
+    std::string navigateByField(Tree* tree, const std::string& current_name, FieldDirection direction,
+                                const std::string& field_direction, int clause_id);
+    // Методы для работы с CNF
+    void removeRootLinkClauses(Tree* tree, const std::string& root_name, const std::string& var_name);
+    void dumpDimacs(Tree* tree, const CnfFormula& formula);
+};
+
+#endif // TRACEANALYZER_H
@@ -0,0 +1,58 @@
+#include "TraceRow.h"
+
+TraceOp traceOpFromString(const std::string& operation)
+{
+    if (operation == "malloc") return TraceOp::Malloc;
+    if (operation == "calloc") return TraceOp::Calloc;
+    if (operation == "realloc") return TraceOp::Realloc;
+    if (operation == "aligned_alloc") return TraceOp::AlignedAlloc;
+    if (operation == "new") return TraceOp::New;
+    if (operation == "new[]") return TraceOp::NewArray;
+    if (operation == "free") return TraceOp::Free;
+    if (operation == "delete") return TraceOp::Delete;
+    if (operation == "delete[]") return TraceOp::DeleteArray;
+    return TraceOp::Unknown;
+}
+
+std::string traceOpName(TraceOp op)
+{
+    switch (op) {
+    case TraceOp::Malloc: return "malloc";
+    case TraceOp::Calloc: return "calloc";
+    case TraceOp::Realloc: return "realloc";
+    case TraceOp::AlignedAlloc: return "aligned_alloc";
+    case TraceOp::New: return "new";
+    case TraceOp::NewArray: return "new[]";
+    case TraceOp::Free: return "free";
+    case TraceOp::Delete: return "delete";
+    case TraceOp::DeleteArray: return "delete[]";
+    default: return std::string();
+    }
+}
+
+bool isAllocationOp(TraceOp op)
+{
+    switch (op) {
+    case TraceOp::Malloc:
+    case TraceOp::Calloc:
+    case TraceOp::Realloc:
+    case TraceOp::AlignedAlloc:
+    case TraceOp::New:
+    case TraceOp::NewArray:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool isDeallocationOp(TraceOp op)
+{
+    return op == TraceOp::Free || op == TraceOp::Delete || op == TraceOp::DeleteArray;
+}
+
+FieldDirection fieldDirectionFromString(const std::string& direction)
+{
+    if (direction == "left") return FieldDirection::Left;
+    if (direction == "right") return FieldDirection::Right;
+    return FieldDirection::Unknown;
+}
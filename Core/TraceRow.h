@@ -0,0 +1,117 @@
+#ifndef TRACEROW_H
+#define TRACEROW_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+// Типизированное представление строк трассы (code.rows).
+// Строится один раз декодером JSON или загрузчиком бинарного формата,
+// после чего анализатор работает без поиска строковых ключей.
+
+// Операция над памятью из строкового значения "value"
+enum class TraceOp : uint8_t {
+    Unknown = 0,   // Нераспознанная строка (сохраняется в TraceValue::text)
+    Malloc,
+    Calloc,
+    Realloc,
+    AlignedAlloc,
+    New,
+    NewArray,
+    Free,
+    Delete,
+    DeleteArray
+};
+
+TraceOp traceOpFromString(const std::string& operation);
+std::string traceOpName(TraceOp op);
+bool isAllocationOp(TraceOp op);
+bool isDeallocationOp(TraceOp op);
+
+// Направление поля "f", разобранное один раз при загрузке трассы
+enum class FieldDirection : uint8_t {
+    Unknown = 0,    // Строка, отличная от "left"/"right"
+    Left,
+    Right
+};
+
+FieldDirection fieldDirectionFromString(const std::string& direction);
+
+// Значение "value"
+struct TraceValue
+{
+    enum Kind : uint8_t {
+        Absent = 0,     // Ключа "value" нет
+        Null,           // null
+        Operation,      // Строка с операцией над памятью
+        Nested,         // Объект {"variable": ..., "field": ...}
+        InvalidNested,  // Объект без "variable"
+        Other           // Значение другого типа (игнорируется)
+    };
+    // Поле "field" вложенного значения
+    enum FieldKind : uint8_t {
+        NoField = 0,    // Поля нет
+        InvalidField,   // Поле не является объектом
+        PlainField,     // Объект без строкового "f"
+        DirectedField   // Объект со строковым "f"
+    };
+
+    Kind kind = Absent;
+    TraceOp op = TraceOp::Unknown;
+    std::string text;               // Operation: исходная строка; Nested: имя переменной
+    FieldKind field_kind = NoField;
+    std::string field_direction;    // DirectedField: значение "f"
+    FieldDirection field_dir = FieldDirection::Unknown; // DirectedField: разобранное "f"
+
+    std::string operationName() const { return op == TraceOp::Unknown ? text : traceOpName(op); }
+};
+
+// Поле структуры {"f": ..., "op": {...}, "value": ...}
+struct TraceField
+{
+    bool valid = false;             // Значение поля является объектом
+    bool has_direction = false;     // "f" задано строкой
+    std::string direction;
+    FieldDirection dir = FieldDirection::Unknown; // Разобранное "f"
+    std::shared_ptr<TraceField> op; // Вложенное поле "op"
+    TraceValue value;
+};
+
+// Строка трассы или элемент тела ветвления/цикла
+struct TraceStatement
+{
+    enum Kind : uint8_t {
+        Variable = 0,   // Строка с "variable"
+        Operation,      // Строка с "operation"
+        Other           // Ни то, ни другое
+    };
+    enum OperationKind : uint8_t {
+        InvalidOperation = 0,   // Нет "op"
+        Loop,
+        Branch,
+        Function,               // Определение функции (тело в body)
+        Call                    // Вызов функции
+    };
+
+    Kind kind = Other;
+    int id = 0;                         // id строки (только для строк верхнего уровня)
+
+    // Variable
+    std::string variable;
+    TraceValue value;
+    std::shared_ptr<TraceField> field;  // Поле структуры, если нет "value"
+
+    // Operation
+    OperationKind operation = InvalidOperation;
+    bool loop_valid = false;            // У цикла есть "condition" и "body"
+    std::vector<TraceStatement> body;   // Тело цикла
+    bool has_branch_true = false;
+    std::vector<TraceStatement> branch_true;
+    bool has_branch_false = false;
+    std::vector<TraceStatement> branch_false;
+    std::string function;               // Function, Call: имя функции
+    std::vector<std::string> arguments; // Function: параметры; Call: переменные-аргументы
+};
+
+#endif // TRACEROW_H
@@ -0,0 +1,39 @@
+#ifndef TRACESOURCE_H
+#define TRACESOURCE_H
+
+#include <string>
+#include <cstdint>
+#include "TraceRow.h"
+
+// Входной слой анализатора: источник типизированных строк трассы.
+// Ядро не зависит от формата: бинарная трасса читается BinaryTraceReader,
+// остальные форматы (JSON) подключаются адаптерами вне ядра.
+class TraceSource
+{
+public:
+    virtual ~TraceSource() {}
+
+    // Число строк трассы (-1, если неизвестно заранее)
+    virtual int64_t rowCount() const = 0;
+    // Следующая строка; false - конец трассы или ошибка (см. hasError)
+    virtual bool next(TraceStatement& row) = 0;
+    // Пропустить строки, уже учтенные в контрольной точке
+    virtual bool skip(int64_t rows)
+    {
+        TraceStatement row;
+        for (int64_t i = 0; i < rows; ++i) {
+            if (!next(row)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool hasError() const { return !error_.empty(); }
+    const std::string& errorString() const { return error_; }
+
+protected:
+    std::string error_;
+};
+
+#endif // TRACESOURCE_H
@@ -0,0 +1,746 @@
+#include "Tree.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+std::atomic<uint64_t> Tree::generationCounter_(0);
+
+namespace {
+
+// Компактная форма вытесненного дерева: целые — varint (со знаком — zigzag)
+void putVarint(std::string& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putSigned(std::string& out, int64_t value)
+{
+    putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+class VarintReader
+{
+public:
+    explicit VarintReader(const std::string& data) : data_(data), offset_(0), ok_(true) {}
+
+    bool failed() const { return !ok_; }
+    bool atEnd() const { return offset_ == data_.size(); }
+    uint64_t next()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64 && offset_ < data_.size(); shift += 7) {
+            unsigned char byte = static_cast<unsigned char>(data_[offset_++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        ok_ = false;
+        return 0;
+    }
+    int64_t nextSigned()
+    {
+        uint64_t value = next();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+    std::string text()
+    {
+        uint64_t length = next();
+        if (!ok_ || length > data_.size() - offset_) {
+            ok_ = false;
+            return std::string();
+        }
+        std::string result = data_.substr(offset_, static_cast<size_t>(length));
+        offset_ += static_cast<size_t>(length);
+        return result;
+    }
+
+private:
+    const std::string& data_;
+    size_t offset_;
+    bool ok_;
+};
+
+// Освободить память контейнера, а не только очистить его
+template <typename Container>
+void release(Container& container)
+{
+    Container().swap(container);
+}
+
+} // namespace
+
+Tree::Tree(const std::string& name)
+    : name_(name), root_(kNoElement), positionAllocator_(nullptr),
+    leaves_(NameOrder(&elementNames_)), rootLinked_(NameOrder(&elementNames_)), recordEvents_(false),
+    spilled_(false), generation_(nextGeneration()), structureGeneration_(0), memoryLinksGeneration_(0)
+{
+
+}
+
+Tree::Tree(const Tree& other)
+    : name_(other.name_),
+    elementTypes_(other.elementTypes_),
+    elementPositions_(other.elementPositions_),
+    elementNames_(other.elementNames_),
+    elementIds_(other.elementIds_),
+    freeIds_(other.freeIds_),
+    connections_(other.connections_),
+    root_(other.root_),
+    positionAllocator_(nullptr),
+    outDegree_(other.outDegree_),
+    rootLinks_(other.rootLinks_),
+    // Множества упорядочены по именам своего дерева, поэтому не копируются вместе со сравнением
+    leaves_(other.leaves_.begin(), other.leaves_.end(), NameOrder(&elementNames_)),
+    rootLinked_(other.rootLinked_.begin(), other.rootLinked_.end(), NameOrder(&elementNames_)),
+    linkGenerations_(other.linkGenerations_),
+    positionIndex_(other.positionIndex_),
+    recordEvents_(false),
+    spilled_(false),
+    generation_(nextGeneration()),
+    structureGeneration_(0),
+    memoryLinksGeneration_(0)
+{
+    // Массивы копируются целиком: идентификаторы элементов сохраняются;
+    // кэш навигации не копируется
+}
+
+Tree& Tree::operator=(const Tree& other)
+{
+    if (this != &other) {
+        name_ = other.name_;
+        elementTypes_ = other.elementTypes_;
+        elementPositions_ = other.elementPositions_;
+        elementNames_ = other.elementNames_;
+        elementIds_ = other.elementIds_;
+        freeIds_ = other.freeIds_;
+        connections_ = other.connections_;
+        root_ = other.root_;
+        outDegree_ = other.outDegree_;
+        rootLinks_ = other.rootLinks_;
+        leaves_.clear();
+        leaves_.insert(other.leaves_.begin(), other.leaves_.end());
+        rootLinked_.clear();
+        rootLinked_.insert(other.rootLinked_.begin(), other.rootLinked_.end());
+        linkGenerations_ = other.linkGenerations_;
+        positionIndex_ = other.positionIndex_;
+        spilled_ = false;
+        // Содержимое заменено целиком: пошаговые события теряют смысл
+        events_.clear();
+        record(TreeEvent::ElementsCleared);
+        navigationCache_.clear();
+        touchStructure();
+        touch();
+    }
+    return *this;
+}
+
+Tree::~Tree()
+{
+}
+
+uint32_t Tree::idOf(const std::string& name) const
+{
+    auto it = elementIds_.find(name);
+    return it != elementIds_.end() ? it->second : kNoElement;
+}
+
+void Tree::setRoot(const TreeElement& root)
+{
+    if (root && root.getTree() == this) {
+        root_ = root.getId();
+    } else if (!root) {
+        root_ = kNoElement;
+    }
+    rebuildRootLinks();
+    touchStructure();
+    record(TreeEvent::RootChanged, root_ != kNoElement ? elementNames_[root_] : std::string(), std::string(),
+           root_ != kNoElement ? elementPositions_[root_] : -1);
+    touch();
+}
+
+TreeElement Tree::addElement(const std::string& name, int type, int position)
+{
+    if (name.empty() || elementIds_.count(name) != 0) {
+        return TreeElement();
+    }
+
+    uint32_t id;
+    if (!freeIds_.empty()) {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+        elementTypes_[id] = static_cast<uint8_t>(type);
+        elementPositions_[id] = position;
+        elementNames_[id] = name;
+        outDegree_[id] = 0;
+        rootLinks_[id] = 0;
+        linkGenerations_[id] = 0;
+    } else {
+        id = static_cast<uint32_t>(elementTypes_.size());
+        elementTypes_.push_back(static_cast<uint8_t>(type));
+        elementPositions_.push_back(position);
+        elementNames_.push_back(name);
+        outDegree_.push_back(0);
+        rootLinks_.push_back(0);
+        linkGenerations_.push_back(0);
+    }
+    elementIds_.emplace(name, id);
+    positionIndex_[position] = id;
+    leaves_.insert(id);
+
+    // Если это первый элемент, устанавливаем его как корень
+    if (elementIds_.size() == 1 && root_ == kNoElement) {
+        root_ = id;
+    }
+    record(TreeEvent::ElementAdded, name, std::string(), position);
+    touch();
+
+    return TreeElement(this, id);
+}
+
+TreeElement Tree::addElement(const TreeElement& element)
+{
+    if (!element) {
+        return TreeElement();
+    }
+    return addElement(element.getName(), element.getType(), element.getPosition());
+}
+
+bool Tree::removeElement(const std::string& name)
+{
+    uint32_t id = idOf(name);
+    if (id == kNoElement) {
+        return false;
+    }
+
+    // Удаляем все соединения, связанные с этим элементом, в порядке добавления
+    auto ignore = [](const Connection&) {};
+    removeConnectionsMatching(ConnectionRange::Involving, id, ignore);
+
+    // Если удаляемый элемент - корень, сбрасываем корень
+    if (root_ == id) {
+        root_ = kNoElement;
+        std::fill(rootLinks_.begin(), rootLinks_.end(), 0);
+        rootLinked_.clear();
+    }
+
+    const int position = elementPositions_[id];
+    // Позиция удаленного элемента может быть выдана повторно
+    if (positionAllocator_) {
+        positionAllocator_->release(position);
+    }
+
+    record(TreeEvent::ElementRemoved, name, std::string(), position);
+
+    auto indexed = positionIndex_.find(position);
+    if (indexed != positionIndex_.end() && indexed->second == id) {
+        positionIndex_.erase(indexed);
+    }
+    // Имя в elementNames_ не стирается: представления соединений удаленного
+    // элемента остаются читаемыми до переиспользования идентификатора
+    elementIds_.erase(elementNames_[id]);
+    leaves_.erase(id);
+    rootLinked_.erase(id);
+    elementTypes_[id] = kFreeSlot;
+    outDegree_[id] = 0;
+    rootLinks_[id] = 0;
+    freeIds_.push_back(id);
+    touchStructure();
+    touch();
+
+    return true;
+}
+
+TreeElement Tree::findElement(const std::string& name) const
+{
+    uint32_t id = idOf(name);
+    return id != kNoElement ? TreeElement(this, id) : TreeElement();
+}
+
+TreeElement Tree::findElementByPosition(int position) const
+{
+    auto it = positionIndex_.find(position);
+    return it != positionIndex_.end() ? TreeElement(this, it->second) : TreeElement();
+}
+
+void Tree::clearElements()
+{
+    // Удаляем все соединения, так как они ссылаются на элементы
+    clearConnections();
+
+    elementTypes_.clear();
+    elementPositions_.clear();
+    elementNames_.clear();
+    elementIds_.clear();
+    freeIds_.clear();
+    outDegree_.clear();
+    rootLinks_.clear();
+    leaves_.clear();
+    rootLinked_.clear();
+    linkGenerations_.clear();
+    positionIndex_.clear();
+    navigationCache_.clear();
+    root_ = kNoElement;
+    record(TreeEvent::ElementsCleared);
+    touchStructure();
+    touch();
+}
+
+bool Tree::addConnection(const std::string& from, const std::string& to,
+                         int positive, int negative, int position)
+{
+    // Проверяем существование элементов
+    uint32_t from_id = idOf(from);
+    uint32_t to_id = idOf(to);
+    if (from_id == kNoElement || to_id == kNoElement) {
+        return false;
+    }
+
+    // Проверяем, нет ли уже такого соединения
+    if (findConnectionIndex(from_id, to_id) >= 0) {
+        return false;
+    }
+
+    ConnectionRecord connection = {from_id, to_id, positive, negative, position};
+    connections_.push_back(connection);
+    indexConnectionAdded(connection);
+    record(TreeEvent::ConnectionAdded, from, to, position);
+    touch();
+    return true;
+}
+
+bool Tree::addConnection(const Connection& connection)
+{
+    if (!connection) {
+        return false;
+    }
+    return addConnection(connection.getFrom(), connection.getTo(), connection.getPositiveLiteral(),
+                         connection.getNegativeLiteral(), connection.getPosition());
+}
+
+int Tree::findConnectionIndex(uint32_t from, uint32_t to) const
+{
+    for (size_t i = 0; i < connections_.size(); ++i) {
+        if (connections_[i].from == from && connections_[i].to == to) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void Tree::eraseConnection(size_t index)
+{
+    const ConnectionRecord removed = connections_[index];
+    indexConnectionRemoved(removed);
+    record(TreeEvent::ConnectionRemoved, elementNames_[removed.from], elementNames_[removed.to], removed.position);
+    // Порядок соединений сохраняется: он определяет порядок клауз и вывода
+    connections_.erase(connections_.begin() + index);
+    touch();
+}
+
+bool Tree::removeConnection(const std::string& from, const std::string& to)
+{
+    uint32_t from_id = idOf(from);
+    uint32_t to_id = idOf(to);
+    if (from_id == kNoElement || to_id == kNoElement) {
+        return false;
+    }
+    int index = findConnectionIndex(from_id, to_id);
+    if (index < 0) {
+        return false;
+    }
+    eraseConnection(static_cast<size_t>(index));
+    return true;
+}
+
+void Tree::removeConnection(int index)
+{
+    if (index >= 0 && index < static_cast<int>(connections_.size())) {
+        eraseConnection(static_cast<size_t>(index));
+    }
+}
+
+Connection Tree::findConnection(const std::string& from, const std::string& to) const
+{
+    uint32_t from_id = idOf(from);
+    uint32_t to_id = idOf(to);
+    if (from_id == kNoElement || to_id == kNoElement) {
+        return Connection();
+    }
+    int index = findConnectionIndex(from_id, to_id);
+    return index >= 0 ? Connection(this, connections_[index]) : Connection();
+}
+
+bool Tree::containsConnection(const std::string& from, const std::string& to) const
+{
+    return static_cast<bool>(findConnection(from, to));
+}
+
+void Tree::clearConnections()
+{
+    connections_.clear();
+
+    // Без соединений все элементы становятся листьями
+    std::fill(outDegree_.begin(), outDegree_.end(), 0);
+    std::fill(rootLinks_.begin(), rootLinks_.end(), 0);
+    rebuildLeaves();
+    rootLinked_.clear();
+    record(TreeEvent::ConnectionsCleared);
+    touchStructure();
+    touch();
+}
+
+void Tree::remapPositions(const std::unordered_map<int, int>& mapping)
+{
+    auto mapped = [&mapping](int position) {
+        auto it = mapping.find(position);
+        return it != mapping.end() ? it->second : position;
+    };
+    positionIndex_.clear();
+    for (uint32_t id = 0; id < elementTypes_.size(); ++id) {
+        if (elementTypes_[id] != kFreeSlot) {
+            elementPositions_[id] = mapped(elementPositions_[id]);
+            positionIndex_[elementPositions_[id]] = id;
+        }
+    }
+
+    for (ConnectionRecord& conn : connections_) {
+        if (conn.positive >= 0) {
+            conn.positive = mapped(conn.positive);
+        }
+        if (conn.negative >= 0) {
+            conn.negative = mapped(conn.negative);
+        }
+    }
+    record(TreeEvent::PositionsRemapped);
+    touch();
+}
+
+void Tree::setEventRecording(bool enabled)
+{
+    recordEvents_ = enabled;
+    if (!enabled) {
+        events_.clear();
+    }
+}
+
+std::vector<TreeEvent> Tree::takeEvents()
+{
+    std::vector<TreeEvent> events;
+    events.swap(events_);
+    return events;
+}
+
+void Tree::spill(std::string& data)
+{
+    data.clear();
+    putVarint(data, elementTypes_.size());
+    for (uint32_t id = 0; id < elementTypes_.size(); ++id) {
+        putVarint(data, elementTypes_[id]);
+        putSigned(data, elementPositions_[id]);
+        putVarint(data, elementNames_[id].size());
+        data.append(elementNames_[id]);
+    }
+    putVarint(data, freeIds_.size());
+    for (uint32_t id : freeIds_) {
+        putVarint(data, id);
+    }
+    putVarint(data, root_ == kNoElement ? 0 : static_cast<uint64_t>(root_) + 1);
+    putVarint(data, connections_.size());
+    for (const ConnectionRecord& conn : connections_) {
+        putVarint(data, conn.from);
+        putVarint(data, conn.to);
+        putSigned(data, conn.positive);
+        putSigned(data, conn.negative);
+        putSigned(data, conn.position);
+    }
+    // Индекс позиций сохраняется как есть: у нескольких элементов позиция может совпадать
+    putVarint(data, positionIndex_.size());
+    for (const auto& entry : positionIndex_) {
+        putSigned(data, entry.first);
+        putVarint(data, entry.second);
+    }
+
+    release(elementTypes_);
+    release(elementPositions_);
+    release(elementNames_);
+    release(elementIds_);
+    release(freeIds_);
+    release(connections_);
+    release(outDegree_);
+    release(rootLinks_);
+    // У множеств свое сравнение по именам: пустое множество по умолчанию его бы потеряло
+    leaves_.clear();
+    rootLinked_.clear();
+    release(linkGenerations_);
+    release(positionIndex_);
+    release(navigationCache_);
+    release(events_);
+    spilled_ = true;
+}
+
+bool Tree::restore(const std::string& data)
+{
+    VarintReader in(data);
+    const uint64_t slot_count = in.next();
+    // Запись слота занимает не меньше трех байт
+    if (slot_count > data.size() / 3) {
+        return false;
+    }
+    const size_t slots = static_cast<size_t>(slot_count);
+    elementTypes_.resize(slots);
+    elementPositions_.resize(slots);
+    elementNames_.resize(slots);
+    for (uint32_t id = 0; id < slots; ++id) {
+        elementTypes_[id] = static_cast<uint8_t>(in.next());
+        elementPositions_[id] = static_cast<int32_t>(in.nextSigned());
+        elementNames_[id] = in.text();
+        if (elementTypes_[id] != kFreeSlot) {
+            elementIds_.emplace(elementNames_[id], id);
+        }
+    }
+    const uint64_t free_count = in.next();
+    for (uint64_t i = 0; i < free_count && !in.failed(); ++i) {
+        uint64_t id = in.next();
+        if (id >= slots) {
+            return false;
+        }
+        freeIds_.push_back(static_cast<uint32_t>(id));
+    }
+    const uint64_t root = in.next();
+    root_ = root == 0 ? kNoElement : static_cast<uint32_t>(root - 1);
+    const uint64_t connection_count = in.next();
+    outDegree_.assign(slots, 0);
+    rootLinks_.assign(slots, 0);
+    linkGenerations_.assign(slots, 0);
+    for (uint64_t i = 0; i < connection_count && !in.failed(); ++i) {
+        ConnectionRecord conn;
+        conn.from = static_cast<uint32_t>(in.next());
+        conn.to = static_cast<uint32_t>(in.next());
+        conn.positive = static_cast<int32_t>(in.nextSigned());
+        conn.negative = static_cast<int32_t>(in.nextSigned());
+        conn.position = static_cast<int32_t>(in.nextSigned());
+        if (conn.from >= slots || conn.to >= slots
+            || elementTypes_[conn.from] == kFreeSlot || elementTypes_[conn.to] == kFreeSlot) {
+            return false;
+        }
+        connections_.push_back(conn);
+        outDegree_[conn.from]++;
+    }
+    const uint64_t index_count = in.next();
+    for (uint64_t i = 0; i < index_count && !in.failed(); ++i) {
+        int position = static_cast<int>(in.nextSigned());
+        uint64_t id = in.next();
+        // Индекс должен указывать на живой элемент: findElementByPosition ему доверяет
+        if (id >= slots || elementTypes_[id] == kFreeSlot) {
+            return false;
+        }
+        positionIndex_[position] = static_cast<uint32_t>(id);
+    }
+    if (in.failed() || !in.atEnd() || (root_ != kNoElement && root_ >= slots)) {
+        return false;
+    }
+    spilled_ = false;
+    rebuildLeaves();
+    rebuildRootLinks();
+    // Кэш навигации не сохранялся: записей нет, номера изменений ссылок не нужны
+    return true;
+}
+
+size_t Tree::memoryUsage() const
+{
+    // Узлы map/unordered_map оцениваются по размеру полезной нагрузки плюс служебные указатели
+    const size_t map_node = 4 * sizeof(void*);
+    const size_t hash_node = 2 * sizeof(void*);
+    size_t bytes = sizeof(Tree);
+    bytes += elementTypes_.capacity() * sizeof(uint8_t);
+    bytes += elementPositions_.capacity() * sizeof(int32_t);
+    bytes += elementNames_.capacity() * sizeof(std::string);
+    for (const std::string& name : elementNames_) {
+        bytes += name.capacity() > 15 ? name.capacity() + 1 : 0;
+    }
+    bytes += elementIds_.size() * (map_node + sizeof(std::pair<const std::string, uint32_t>));
+    for (const auto& entry : elementIds_) {
+        bytes += entry.first.capacity() > 15 ? entry.first.capacity() + 1 : 0;
+    }
+    bytes += freeIds_.capacity() * sizeof(uint32_t);
+    bytes += connections_.capacity() * sizeof(ConnectionRecord);
+    bytes += outDegree_.capacity() * sizeof(int) + rootLinks_.capacity() * sizeof(int);
+    bytes += (leaves_.size() + rootLinked_.size()) * (map_node + sizeof(uint32_t));
+    bytes += linkGenerations_.capacity() * sizeof(uint64_t);
+    bytes += positionIndex_.bucket_count() * sizeof(void*)
+             + positionIndex_.size() * (hash_node + sizeof(std::pair<const int, uint32_t>));
+    bytes += navigationCache_.bucket_count() * sizeof(void*)
+             + navigationCache_.size() * (hash_node + sizeof(std::pair<const uint64_t, NavigationEntry>));
+    bytes += events_.capacity() * sizeof(TreeEvent);
+    return bytes;
+}
+
+void Tree::clear()
+{
+    clearConnections();
+    clearElements();
+    name_.clear();
+}
+
+bool Tree::isValid() const
+{
+    // Дерево считается валидным, если:
+    // 1. Есть имя
+    // 2. Есть корневой элемент
+    // 3. Все соединения ссылаются на существующие элементы
+    if (name_.empty() || root_ == kNoElement) {
+        return false;
+    }
+
+    // Проверяем соединения
+    for (const ConnectionRecord& conn : connections_) {
+        if (!isElementId(conn.from) || !isElementId(conn.to)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string Tree::toString() const
+{
+    std::ostringstream result;
+    result << "Tree: '" << name_ << "'\n";
+    result << "  Elements: " << elementIds_.size() << "\n";
+    result << "  Connections: " << connections_.size() << "\n";
+    result << "  Root: " << (root_ != kNoElement ? elementNames_[root_] : "None") << "\n";
+    result << "  Valid: " << (isValid() ? "Yes" : "No");
+    return result.str();
+}
+
+bool Tree::hasConnectionToRoot(const std::string& elementName) const
+{
+    if (root_ == kNoElement) return false;
+    uint32_t id = idOf(elementName);
+    return id != kNoElement && rootLinks_[id] != 0;
+}
+
+int Tree::getOutDegree(const std::string& elementName) const
+{
+    uint32_t id = idOf(elementName);
+    return id != kNoElement ? outDegree_[id] : 0;
+}
+
+TreeElement Tree::findCachedNavigation(uint32_t from, int field) const
+{
+    auto it = navigationCache_.find((static_cast<uint64_t>(from) << 8) | static_cast<uint8_t>(field));
+    if (it == navigationCache_.end() || !isElementId(from)) {
+        return TreeElement();
+    }
+    // Все номера изменений берутся из общего счетчика, поэтому любое изменение
+    // после записи дает номер больше сохраненного
+    const uint64_t stored = it->second.generation;
+    if (structureGeneration_ > stored || memoryLinksGeneration_ > stored || linkGenerations_[from] > stored) {
+        return TreeElement();
+    }
+    return TreeElement(this, it->second.target);
+}
+
+void Tree::cacheNavigation(uint32_t from, int field, uint32_t target)
+{
+    navigationCache_[(static_cast<uint64_t>(from) << 8) | static_cast<uint8_t>(field)] = {target, generationCounter_.load(std::memory_order_relaxed)};
+}
+
+void Tree::touchLinks(const ConnectionRecord& connection)
+{
+    if (connection.to == root_) {
+        return;
+    }
+    const uint64_t generation = nextGeneration();
+    linkGenerations_[connection.from] = generation;
+    if (elementTypes_[connection.from] == TreeElement::MEMORY) {
+        memoryLinksGeneration_ = generation;
+    }
+}
+
+void Tree::indexConnectionAdded(const ConnectionRecord& connection)
+{
+    if (outDegree_[connection.from]++ == 0) {
+        leaves_.erase(connection.from);
+    }
+    touchLinks(connection);
+
+    if (root_ != kNoElement) {
+        if (connection.from == root_ && rootLinks_[connection.to]++ == 0) {
+            rootLinked_.insert(connection.to);
+        }
+        if (connection.to == root_ && rootLinks_[connection.from]++ == 0) {
+            rootLinked_.insert(connection.from);
+        }
+    }
+}
+
+void Tree::indexConnectionRemoved(const ConnectionRecord& connection)
+{
+    touchLinks(connection);
+    if (outDegree_[connection.from] > 0 && --outDegree_[connection.from] == 0) {
+        leaves_.insert(connection.from);
+    }
+
+    if (root_ != kNoElement) {
+        if (connection.from == root_ && rootLinks_[connection.to] > 0 && --rootLinks_[connection.to] == 0) {
+            rootLinked_.erase(connection.to);
+        }
+        if (connection.to == root_ && rootLinks_[connection.from] > 0 && --rootLinks_[connection.from] == 0) {
+            rootLinked_.erase(connection.from);
+        }
+    }
+}
+
+void Tree::rebuildRootLinks()
+{
+    std::fill(rootLinks_.begin(), rootLinks_.end(), 0);
+    rootLinked_.clear();
+    if (root_ == kNoElement) return;
+
+    for (const ConnectionRecord& conn : connections_) {
+        if (conn.from == root_ && rootLinks_[conn.to]++ == 0) {
+            rootLinked_.insert(conn.to);
+        }
+        if (conn.to == root_ && rootLinks_[conn.from]++ == 0) {
+            rootLinked_.insert(conn.from);
+        }
+    }
+}
+
+void Tree::rebuildLeaves()
+{
+    // elementIds_ уже упорядочен по именам: вставка в конец без поиска места
+    leaves_.clear();
+    for (const auto& entry : elementIds_) {
+        if (outDegree_[entry.second] == 0) {
+            leaves_.insert(leaves_.end(), entry.second);
+        }
+    }
+}
+
+void Tree::printDebugInfo(int row_number) const
+{
+    std::cout << "=== Tree: " << name_ << " at row " << row_number << " ===" << std::endl;
+    std::cout << "Root: " << (root_ != kNoElement ? elementNames_[root_] : "None") << std::endl;
+    std::cout << "Elements: " << elementIds_.size() << std::endl;
+    std::cout << "Connections: " << connections_.size() << std::endl;
+
+    std::cout << "--- Elements ---" << std::endl;
+    for (const TreeElement& element : getElements()) {
+        std::cout << "  " << element.getName() << " [type:" << element.getType()
+                  << ", pos:" << element.getPosition() << "]" << std::endl;
+    }
+
+    std::cout << "--- Connections ---" << std::endl;
+    for (const ConnectionRecord& conn : connections_) {
+        std::cout << "  " << elementNames_[conn.from] << " -> " << elementNames_[conn.to]
+                  << " [pos:" << conn.position << "]" << std::endl;
+    }
+    std::cout << "==================" << std::endl;
+}
@@ -0,0 +1,451 @@
+#ifndef TREE_H
+#define TREE_H
+
+#include <string>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <iterator>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "TreeElement.h"
+#include "Connection.h"
+#include "PositionAllocator.h"
+
+// Изменение дерева, записанное для построчного отчета об изменениях
+struct TreeEvent
+{
+    enum Kind {
+        ElementAdded,
+        ElementRemoved,
+        ConnectionAdded,
+        ConnectionRemoved,
+        RootChanged,
+        ElementsCleared,
+        ConnectionsCleared,
+        PositionsRemapped
+    };
+
+    Kind kind;
+    std::string name;   // Имя элемента или источник соединения
+    std::string target; // Приемник соединения
+    int position;       // Позиция элемента или соединения (-1, если неприменимо)
+};
+
+// Дерево хранит элементы структурой массивов: тип, позиция и имя лежат в
+// параллельных массивах, индексируемых идентификатором элемента; соединения —
+// плоский массив записей ConnectionRecord. TreeElement и Connection — легкие
+// представления над этими массивами
+class Tree
+{
+public:
+    // Идентификатор, не соответствующий ни одному элементу
+    static const uint32_t kNoElement = UINT32_MAX;
+
+    // Множество идентификаторов элементов в порядке имен (порядок обхода getElements).
+    // Имя идентификатора не меняется, пока он во множестве: идентификатор удаляется
+    // из множеств вместе с элементом
+    struct NameOrder
+    {
+        explicit NameOrder(const std::vector<std::string>* names) : names_(names) {}
+        bool operator()(uint32_t a, uint32_t b) const { return (*names_)[a] < (*names_)[b]; }
+
+    private:
+        const std::vector<std::string>* names_;
+    };
+    typedef std::set<uint32_t, NameOrder> IdSet;
+
+    // Диапазон соединений без копирования: итератор проходит плоский массив записей
+    // и выдает представления Connection только для подходящих записей.
+    // Действителен до следующего изменения дерева
+    class ConnectionRange
+    {
+    public:
+        enum Filter { All, From, To, Involving };
+
+        class Iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef Connection value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const Connection* pointer;
+            typedef Connection reference;
+
+            Iterator(const ConnectionRange* range, const ConnectionRecord* current)
+                : range_(range), current_(current) { skip(); }
+            Connection operator*() const { return Connection(range_->tree_, *current_); }
+            Iterator& operator++() { ++current_; skip(); return *this; }
+            bool operator==(const Iterator& other) const { return current_ == other.current_; }
+            bool operator!=(const Iterator& other) const { return current_ != other.current_; }
+
+        private:
+            const ConnectionRange* range_;
+            const ConnectionRecord* current_;
+
+            void skip()
+            {
+                while (current_ != range_->end_ && !range_->matches(*current_)) {
+                    ++current_;
+                }
+            }
+        };
+
+        ConnectionRange(const Tree* tree, Filter filter = All, uint32_t id = kNoElement)
+            : tree_(tree),
+            begin_(tree->connections_.data()),
+            end_(tree->connections_.data() + tree->connections_.size()),
+            filter_(filter),
+            id_(id) {}
+
+        Iterator begin() const { return Iterator(this, begin_); }
+        Iterator end() const { return Iterator(this, end_); }
+        bool empty() const { return !(begin() != end()); }
+        size_t size() const
+        {
+            if (filter_ == All) {
+                return static_cast<size_t>(end_ - begin_);
+            }
+            size_t count = 0;
+            for (const ConnectionRecord* it = begin_; it != end_; ++it) {
+                count += matches(*it) ? 1 : 0;
+            }
+            return count;
+        }
+
+        bool matches(const ConnectionRecord& connection) const
+        {
+            switch (filter_) {
+            case From: return connection.from == id_;
+            case To: return connection.to == id_;
+            case Involving: return connection.from == id_ || connection.to == id_;
+            default: return true;
+            }
+        }
+
+    private:
+        const Tree* tree_;
+        const ConnectionRecord* begin_;
+        const ConnectionRecord* end_;
+        Filter filter_;
+        uint32_t id_;
+    };
+
+    // Диапазон элементов в порядке имен без копирования (на этот порядок опирается вывод).
+    // Листья и элементы, связанные с корнем, обходятся по множествам дерева, остальные
+    // фильтры — по всем элементам. Действителен до следующего изменения дерева
+    class ElementRange
+    {
+    public:
+        enum Filter { All, Leaves, RootLinked, OfType };
+        typedef std::map<std::string, uint32_t>::const_iterator Position;
+        typedef IdSet::const_iterator IndexPosition;
+
+        class Iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef TreeElement value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const TreeElement* pointer;
+            typedef TreeElement reference;
+
+            Iterator(const ElementRange* range, Position current)
+                : range_(range), current_(current) { skip(); }
+            Iterator(const ElementRange* range, IndexPosition indexed)
+                : range_(range), indexed_(indexed) {}
+            TreeElement operator*() const
+            {
+                return TreeElement(range_->tree_, range_->index_ ? *indexed_ : current_->second);
+            }
+            Iterator& operator++()
+            {
+                if (range_->index_) {
+                    ++indexed_;
+                } else {
+                    ++current_;
+                    skip();
+                }
+                return *this;
+            }
+            bool operator==(const Iterator& other) const
+            {
+                return range_->index_ ? indexed_ == other.indexed_ : current_ == other.current_;
+            }
+            bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+        private:
+            const ElementRange* range_;
+            Position current_;
+            IndexPosition indexed_;
+
+            void skip()
+            {
+                while (current_ != range_->tree_->elementIds_.end() && !range_->matches(current_->second)) {
+                    ++current_;
+                }
+            }
+        };
+
+        ElementRange(const Tree* tree, Filter filter = All, int type = 0)
+            : tree_(tree),
+            filter_(filter),
+            type_(type),
+            index_(filter == Leaves ? &tree->leaves_ : filter == RootLinked ? &tree->rootLinked_ : nullptr) {}
+
+        Iterator begin() const
+        {
+            return index_ ? Iterator(this, index_->begin()) : Iterator(this, tree_->elementIds_.begin());
+        }
+        Iterator end() const
+        {
+            return index_ ? Iterator(this, index_->end()) : Iterator(this, tree_->elementIds_.end());
+        }
+        bool empty() const { return !(begin() != end()); }
+        size_t size() const
+        {
+            if (index_) {
+                return index_->size();
+            }
+            if (filter_ == All) {
+                return tree_->elementIds_.size();
+            }
+            size_t count = 0;
+            for (Iterator it = begin(); it != end(); ++it) {
+                ++count;
+            }
+            return count;
+        }
+
+        bool matches(uint32_t id) const
+        {
+            return filter_ != OfType || tree_->elementTypes_[id] == type_;
+        }
+
+    private:
+        const Tree* tree_;
+        Filter filter_;
+        int type_;
+        const IdSet* index_;        // Множество дерева для Leaves и RootLinked
+    };
+
+    Tree(const std::string& name = std::string());
+    Tree(const Tree& other);
+    Tree& operator=(const Tree& other);
+    ~Tree();
+
+    // Геттеры
+    const std::string& getName() const { return name_; }
+    TreeElement getRoot() const { return root_ != kNoElement ? TreeElement(this, root_) : TreeElement(); }
+    // Элементы в порядке имен (на этот порядок опирается вывод)
+    ElementRange getElements() const { return ElementRange(this); }
+    // Соединения в порядке добавления
+    ConnectionRange getConnections() const { return ConnectionRange(this); }
+    // Плоский массив соединений; ссылка действительна до следующего изменения дерева
+    const std::vector<ConnectionRecord>& getConnectionRecords() const { return connections_; }
+
+    // Сеттеры
+    void setName(const std::string& name) { name_ = name; touch(); }
+    // Корень должен быть элементом этого дерева; пустое представление сбрасывает корень
+    void setRoot(const TreeElement& root);
+    // Распределитель, в который возвращаются позиции удаленных элементов (не владеет)
+    void setPositionAllocator(PositionAllocator* allocator) { positionAllocator_ = allocator; }
+    PositionAllocator* getPositionAllocator() const { return positionAllocator_; }
+
+    // Методы для работы с элементами (пустое представление — элемент не добавлен/не найден)
+    TreeElement addElement(const std::string& name, int type, int position);
+    // Копия элемента другого дерева
+    TreeElement addElement(const TreeElement& element);
+    bool removeElement(const std::string& name);
+    TreeElement findElement(const std::string& name) const;
+    // Элемент с заданной позицией переменной (индекс позиция -> элемент)
+    TreeElement findElementByPosition(int position) const;
+    bool containsElement(const std::string& name) const { return elementIds_.count(name) != 0; }
+    int getElementCount() const { return static_cast<int>(elementIds_.size()); }
+    void clearElements();
+
+    // Доступ к массивам элементов по идентификатору
+    bool isElementId(uint32_t id) const { return id < elementTypes_.size() && elementTypes_[id] != kFreeSlot; }
+    const std::string& elementName(uint32_t id) const { return elementNames_[id]; }
+    int elementType(uint32_t id) const { return elementTypes_[id]; }
+    int elementPosition(uint32_t id) const { return elementPositions_[id]; }
+
+    // Методы для работы с соединениями
+    // positive — позиция приемника, negative — позиция источника (-1 — без литерала)
+    bool addConnection(const std::string& from, const std::string& to,
+                       int positive, int negative, int position = -1);
+    // Копия соединения (в том числе другого дерева): концы сопоставляются по именам
+    bool addConnection(const Connection& connection);
+    bool removeConnection(const std::string& from, const std::string& to);
+    void removeConnection(int index);
+    Connection findConnection(const std::string& from, const std::string& to) const;
+    bool containsConnection(const std::string& from, const std::string& to) const;
+    int getConnectionCount() const { return static_cast<int>(connections_.size()); }
+    void clearConnections();
+
+    // Методы для работы с деревом в целом
+    bool isEmpty() const { return elementIds_.empty(); }
+    void clear();
+    bool isValid() const;
+    std::string toString() const;
+
+    // Поиск и обход без копирования (линейный проход по массивам)
+    ElementRange findElementsByType(int type) const { return ElementRange(this, ElementRange::OfType, type); }
+    ConnectionRange getConnectionsFrom(const std::string& elementName) const
+    {
+        return ConnectionRange(this, ConnectionRange::From, idOf(elementName));
+    }
+    ConnectionRange getConnectionsTo(const std::string& elementName) const
+    {
+        return ConnectionRange(this, ConnectionRange::To, idOf(elementName));
+    }
+
+    // Получить все соединения, где указанный элемент является отправителем или получателем
+    ConnectionRange getConnectionsInvolving(const std::string& elementName) const
+    {
+        return ConnectionRange(this, ConnectionRange::Involving, idOf(elementName));
+    }
+
+    // Удалить исходящие/входящие соединения элемента за один проход по массиву.
+    // Посетитель вызывается для каждого удаляемого соединения до удаления и не должен
+    // изменять дерево. Возвращает число удаленных соединений
+    template <typename Visitor>
+    int removeConnectionsFrom(const std::string& elementName, Visitor onRemoved)
+    {
+        return removeConnectionsMatching(ConnectionRange::From, idOf(elementName), onRemoved);
+    }
+    template <typename Visitor>
+    int removeConnectionsTo(const std::string& elementName, Visitor onRemoved)
+    {
+        return removeConnectionsMatching(ConnectionRange::To, idOf(elementName), onRemoved);
+    }
+
+    // Перенумеровать позиции элементов и литералы соединений (уплотнение)
+    void remapPositions(const std::unordered_map<int, int>& mapping);
+
+    // Проверить, есть ли связь с корнем у элемента
+    bool hasConnectionToRoot(const std::string& elementName) const;
+
+    // Инкрементально поддерживаемые множества (обход — только по их элементам)
+    ElementRange getLeaves() const { return ElementRange(this, ElementRange::Leaves); }      // Элементы без исходящих соединений
+    ElementRange getRootLinkedElements() const { return ElementRange(this, ElementRange::RootLinked); } // Элементы, связанные с корнем в любую сторону
+    int getOutDegree(const std::string& elementName) const;
+
+    // Номер последнего изменения дерева: уникален среди всех деревьев и растет
+    // при каждой модификации через методы Tree
+    uint64_t getGeneration() const { return generation_; }
+
+    // Кэш навигации по полям: ключ — элемент и код поля, значение — найденный элемент.
+    // Запись действительна, пока не менялись исходящие соединения элемента, исходящие
+    // соединения элементов памяти и состав элементов. Обратные связи с корнем не
+    // учитываются: навигация по полям через них не проходит
+    TreeElement findCachedNavigation(uint32_t from, int field) const;
+    void cacheNavigation(uint32_t from, int field, uint32_t target);
+
+    // Журнал изменений: при включенной записи каждая модификация через методы Tree
+    // добавляет событие; takeEvents() забирает накопленные события и очищает журнал
+    void setEventRecording(bool enabled);
+    bool isRecordingEvents() const { return recordEvents_; }
+    std::vector<TreeEvent> takeEvents();
+    bool hasPendingEvents() const { return !events_.empty(); }
+
+    // Вытеснение: spill() записывает массивы дерева в компактную форму и освобождает их;
+    // имя, поколение и настройки остаются. До restore() вытесненное дерево нельзя ни
+    // читать, ни менять (TreeManager::getTree восстанавливает его сам). Идентификаторы
+    // элементов и поколение при вытеснении и восстановлении не меняются
+    void spill(std::string& data);
+    bool restore(const std::string& data);
+    bool isSpilled() const { return spilled_; }
+    // Оценка памяти массивов и индексов дерева в байтах
+    size_t memoryUsage() const;
+private:
+    // Тип свободного идентификатора в elementTypes_
+    static const uint8_t kFreeSlot = 0xFF;
+
+    std::string name_;
+    // Параллельные массивы элементов, индекс — идентификатор элемента
+    std::vector<uint8_t> elementTypes_;
+    std::vector<int32_t> elementPositions_;
+    std::vector<std::string> elementNames_;    // Имя сохраняется до переиспользования идентификатора
+    std::map<std::string, uint32_t> elementIds_; // Имя -> идентификатор (задает порядок обхода по имени)
+    std::vector<uint32_t> freeIds_;            // Идентификаторы удаленных элементов
+    std::vector<ConnectionRecord> connections_; // Соединения в порядке добавления
+    uint32_t root_;                            // Идентификатор корня или kNoElement
+    PositionAllocator* positionAllocator_;     // Источник позиций элементов (может отсутствовать)
+
+    // Счетчики, обновляемые при каждом добавлении/удалении (индекс — идентификатор)
+    std::vector<int> outDegree_;               // Число исходящих соединений
+    std::vector<int> rootLinks_;               // Число соединений с корнем
+    IdSet leaves_;                             // Элементы с нулевой исходящей степенью
+    IdSet rootLinked_;                         // Элементы с ненулевым rootLinks_
+    std::vector<uint64_t> linkGenerations_;    // Номер последнего изменения исходящих соединений
+    std::unordered_map<int, uint32_t> positionIndex_; // Позиция переменной -> идентификатор
+
+    bool recordEvents_;                     // Записывать события изменений
+    std::vector<TreeEvent> events_;         // Изменения с последнего takeEvents()
+
+    bool spilled_;                          // Массивы вытеснены (см. spill)
+    uint64_t generation_;                   // Номер последнего изменения
+    uint64_t structureGeneration_;          // Номер последнего изменения состава элементов или корня
+    uint64_t memoryLinksGeneration_;        // Номер последнего изменения соединений от памяти
+    // Общий счетчик изменений всех деревьев; деревья разных анализаторов меняются
+    // из рабочих потоков демона одновременно
+    static std::atomic<uint64_t> generationCounter_;
+
+    struct NavigationEntry {
+        uint32_t target;
+        uint64_t generation;                // Значение общего счетчика при записи
+    };
+    std::unordered_map<uint64_t, NavigationEntry> navigationCache_;
+
+    static uint64_t nextGeneration() { return generationCounter_.fetch_add(1, std::memory_order_relaxed) + 1; }
+    void touch() { generation_ = nextGeneration(); }
+    void touchStructure() { structureGeneration_ = nextGeneration(); }
+    void touchLinks(const ConnectionRecord& connection);
+    void record(TreeEvent::Kind kind, const std::string& name = std::string(),
+                const std::string& target = std::string(), int position = -1)
+    {
+        if (recordEvents_) {
+            events_.push_back({kind, name, target, position});
+        }
+    }
+
+    uint32_t idOf(const std::string& name) const;
+    int findConnectionIndex(uint32_t from, uint32_t to) const;
+    void eraseConnection(size_t index);
+
+    // Удаление подходящих соединений с уплотнением массива (порядок остальных сохраняется)
+    template <typename Visitor>
+    int removeConnectionsMatching(ConnectionRange::Filter filter, uint32_t id, Visitor& onRemoved)
+    {
+        const ConnectionRange range(this, filter, id);
+        size_t kept = 0;
+        int removed = 0;
+        for (size_t i = 0; i < connections_.size(); ++i) {
+            const ConnectionRecord connection = connections_[i];
+            if (range.matches(connection)) {
+                onRemoved(Connection(this, connection));
+                indexConnectionRemoved(connection);
+                record(TreeEvent::ConnectionRemoved, elementNames_[connection.from],
+                       elementNames_[connection.to], connection.position);
+                ++removed;
+            } else {
+                connections_[kept++] = connection;
+            }
+        }
+        connections_.resize(kept);
+        if (removed > 0) {
+            touch();
+        }
+        return removed;
+    }
+    void printDebugInfo(int row_number) const;
+    void indexConnectionAdded(const ConnectionRecord& connection);
+    void indexConnectionRemoved(const ConnectionRecord& connection);
+    void rebuildRootLinks();
+    void rebuildLeaves();
+};
+
+#endif // TREE_H
@@ -0,0 +1,58 @@
+#include "TreeElement.h"
+#include "Tree.h"
+#include <sstream>
+
+TreeElement::operator bool() const
+{
+    return tree_ && tree_->isElementId(id_);
+}
+
+const std::string& TreeElement::getName() const
+{
+    return tree_->elementName(id_);
+}
+
+int TreeElement::getType() const
+{
+    return tree_->elementType(id_);
+}
+
+int TreeElement::getPosition() const
+{
+    return tree_->elementPosition(id_);
+}
+
+const char* TreeElement::getTypeName() const
+{
+    return typeName(getType());
+}
+
+const char* TreeElement::typeName(int type)
+{
+    switch (type) {
+    case ROOT: return "ROOT";
+    case MEMORY: return "MEMORY";
+    case NULL_ELEMENT: return "NULL_ELEMENT";
+    case LEFT_VARIABLE: return "LEFT_VARIABLE";
+    case RIGHT_VARIABLE: return "RIGHT_VARIABLE";
+    default: return "UNKNOWN";
+    }
+}
+
+bool TreeElement::isValid() const
+{
+    // Элемент считается валидным, если он существует, имя не пустое
+    // и позиция не отрицательная
+    return *this && !getName().empty() && getPosition() >= 0;
+}
+
+std::string TreeElement::toString() const
+{
+    if (!*this) {
+        return "TreeElement[none]";
+    }
+    std::ostringstream result;
+    result << "TreeElement[name: '" << getName() << "', type: " << getType()
+           << " (" << getTypeName() << "), position: " << getPosition() << "]";
+    return result.str();
+}
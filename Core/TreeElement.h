@@ -0,0 +1,60 @@
+#ifndef TREEELEMENT_H
+#define TREEELEMENT_H
+
+#include <string>
+#include <cstdint>
+
+class Tree;
+
+// Представление элемента дерева. Сами данные лежат в параллельных массивах Tree
+// (тип, позиция, имя); представление хранит только дерево и идентификатор элемента.
+// После удаления элемента представление становится недействительным
+class TreeElement
+{
+public:
+    // Типы элементов
+    enum Type {
+        ROOT = 0, // Корень дерева
+        MEMORY = 1, // Память (создается после malloc)
+        NULL_ELEMENT = 2, // Null
+        LEFT_VARIABLE = 3, // Левая переменная
+        RIGHT_VARIABLE = 4 // Правая переменная
+    };
+
+    TreeElement() : tree_(nullptr), id_(0) {}
+    TreeElement(const Tree* tree, uint32_t id) : tree_(tree), id_(id) {}
+
+    // Представление указывает на существующий элемент
+    explicit operator bool() const;
+
+    // Операторы сравнения: один и тот же элемент одного дерева
+    bool operator==(const TreeElement& other) const { return tree_ == other.tree_ && id_ == other.id_; }
+    bool operator!=(const TreeElement& other) const { return !(*this == other); }
+
+    // Геттеры
+    const std::string& getName() const;
+    int getType() const;
+    int getPosition() const;
+    const char* getTypeName() const;
+    uint32_t getId() const { return id_; }
+    const Tree* getTree() const { return tree_; }
+
+    // Вспомогательные методы
+    bool isValid() const;
+    std::string toString() const;
+
+    // Проверки типов
+    bool isRoot() const { return getType() == ROOT; }
+    bool isMemory() const { return getType() == MEMORY; }
+    bool isNull() const { return getType() == NULL_ELEMENT; }
+    bool isLeftVariable() const { return getType() == LEFT_VARIABLE; }
+    bool isRightVariable() const { return getType() == RIGHT_VARIABLE; }
+
+    static const char* typeName(int type);
+
+private:
+    const Tree* tree_;
+    uint32_t id_;
+};
+
+#endif // TREEELEMENT_H
@@ -0,0 +1,295 @@
+#include "TreeManager.h"
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+TreeManager::TreeManager()
+    : treeCount_(0),
+    budget_(0),
+    spill_end_(0),
+    scans_(0),
+    resident_bytes_(0),
+    spilled_count_(0)
+{
+}
+
+TreeManager::~TreeManager()
+{
+    clear();
+    if (spill_file_.is_open()) {
+        spill_file_.close();
+        std::remove(spill_path_.c_str());
+    }
+}
+
+void TreeManager::addTree(const std::string& name, Tree* tree)
+{
+    if (tree && !name.empty()) {
+        auto it = trees_.find(name);
+        if (it == trees_.end()) {
+            treeCount_++;
+            trees_.emplace(name, tree);
+        } else {
+            forget(name);
+            it->second = tree;
+        }
+    }
+}
+
+void TreeManager::removeTree(const std::string& name)
+{
+    auto it = trees_.find(name);
+    if (it != trees_.end() && it->second) {
+        // Имя могло принадлежать удаляемому дереву
+        Tree* tree = it->second;
+        forget(name);
+        trees_.erase(it);
+        delete tree;
+        treeCount_--;
+    }
+}
+
+Tree* TreeManager::getTree(const std::string& name) const
+{
+    auto it = trees_.find(name);
+    if (it == trees_.end()) {
+        return nullptr;
+    }
+    Tree* tree = it->second;
+    if (tree && tree->isSpilled()) {
+        Residency& residency = residency_[name];
+        if (!restore(name, tree, residency)) {
+            return nullptr;
+        }
+        // Дерево было холодным: в проходе по деревьям его снова вытесняют первым
+        eviction_order_.push_front(name);
+    }
+    return tree;
+}
+
+bool TreeManager::containsTree(const std::string& name) const
+{
+    return trees_.count(name) != 0;
+}
+
+void TreeManager::clear()
+{
+    for (auto& entry : trees_) {
+        delete entry.second;
+    }
+    trees_.clear();
+    treeCount_ = 0;
+    residency_.clear();
+    eviction_order_.clear();
+    // Записи файла вытеснения больше никому не принадлежат
+    spill_free_.clear();
+    spill_end_ = 0;
+    resident_bytes_ = 0;
+    spilled_count_ = 0;
+}
+
+void TreeManager::setMemoryBudget(size_t bytes, const std::string& spill_path)
+{
+    budget_ = bytes;
+    if (spill_path.empty() || spill_path == spill_path_) {
+        return;
+    }
+    spill_path_ = spill_path;
+    spill_file_.open(spill_path_, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    spill_end_ = 0;
+    if (!spill_file_) {
+        error_ = "Failed to open spill file: " + spill_path_;
+    }
+}
+
+void TreeManager::releaseColdTrees(const Tree* keep) const
+{
+    if (budget_ == 0) {
+        return;
+    }
+    ++scans_;
+    size_t total = 0;
+    std::vector<std::pair<uint64_t, const std::string*>> candidates;
+    for (const auto& entry : trees_) {
+        Residency& residency = residency_[entry.first];
+        const Tree* tree = entry.second;
+        if (tree->isSpilled()) {
+            total += residency.data.size();
+            continue;
+        }
+        // Память пересчитывается только у изменившихся деревьев
+        if (residency.generation != tree->getGeneration()) {
+            residency.generation = tree->getGeneration();
+            residency.changed_at = scans_;
+            residency.bytes = tree->memoryUsage();
+        }
+        total += residency.bytes;
+        if (tree != keep) {
+            candidates.emplace_back(residency.changed_at, &entry.first);
+        }
+    }
+    resident_bytes_ = total;
+    eviction_order_.clear();
+    if (resident_bytes_ <= budget_) {
+        return;
+    }
+    // Первыми вытесняются деревья, дольше всех не менявшиеся
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const std::pair<uint64_t, const std::string*>& a,
+                        const std::pair<uint64_t, const std::string*>& b) { return a.first < b.first; });
+    for (const auto& candidate : candidates) {
+        eviction_order_.push_back(*candidate.second);
+    }
+    trimToBudget(keep);
+}
+
+void TreeManager::trimToBudget(const Tree* keep) const
+{
+    while (budget_ != 0 && resident_bytes_ > budget_ && !eviction_order_.empty() && error_.empty()) {
+        const std::string name = eviction_order_.front();
+        eviction_order_.pop_front();
+        auto it = trees_.find(name);
+        if (it == trees_.end()) {
+            continue;
+        }
+        Tree* tree = it->second;
+        // Неотданные события нужны отчету об изменениях текущей строки
+        if (tree == keep || tree->isSpilled() || tree->hasPendingEvents()) {
+            continue;
+        }
+        spill(tree, residency_[name]);
+    }
+}
+
+bool TreeManager::spill(Tree* tree, Residency& residency) const
+{
+    const size_t bytes = residency.bytes;
+    if (!spill_file_.is_open()) {
+        tree->spill(residency.data);
+        residency.data.shrink_to_fit();
+        resident_bytes_ = resident_bytes_ - std::min(resident_bytes_, bytes) + residency.data.size();
+        spilled_count_++;
+        return true;
+    }
+    std::string data;
+    const uint64_t generation = tree->getGeneration();
+    tree->spill(data);
+    // Неизменное дерево уже записано в файл при прошлом вытеснении. Измененное
+    // переписывается на свое место, если помещается, иначе место освобождается
+    if (residency.offset < 0 || residency.stored_generation != generation) {
+        if (residency.offset >= 0 && data.size() > residency.capacity) {
+            releaseSpill(residency);
+        }
+        if (residency.offset < 0) {
+            residency.offset = allocateSpill(data.size(), residency.capacity);
+        }
+        spill_file_.seekp(residency.offset);
+        spill_file_.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!spill_file_) {
+            error_ = "Failed to write spill file: " + spill_path_;
+            spill_file_.clear();
+            releaseSpill(residency);
+            tree->restore(data);
+            return false;
+        }
+        residency.stored_size = data.size();
+        residency.stored_generation = generation;
+    }
+    resident_bytes_ -= std::min(resident_bytes_, bytes);
+    spilled_count_++;
+    return true;
+}
+
+bool TreeManager::restore(const std::string& name, Tree* tree, Residency& residency) const
+{
+    bool restored;
+    if (!spill_file_.is_open()) {
+        restored = tree->restore(residency.data);
+        resident_bytes_ -= std::min(resident_bytes_, residency.data.size());
+        std::string().swap(residency.data);
+    } else {
+        std::string data(residency.stored_size, '\0');
+        spill_file_.seekg(residency.offset);
+        spill_file_.read(&data[0], static_cast<std::streamsize>(data.size()));
+        restored = spill_file_ && tree->restore(data);
+        spill_file_.clear();
+    }
+    if (!restored) {
+        error_ = "Failed to restore spilled tree: " + name;
+        return false;
+    }
+    resident_bytes_ += residency.bytes;
+    spilled_count_--;
+    return true;
+}
+
+int64_t TreeManager::allocateSpill(size_t size, size_t& capacity) const
+{
+    // Первое подходящее свободное место; остаток больше половины записи остается свободным
+    for (auto it = spill_free_.begin(); it != spill_free_.end(); ++it) {
+        if (it->second < size) {
+            continue;
+        }
+        const int64_t offset = it->first;
+        capacity = it->second;
+        spill_free_.erase(it);
+        if (capacity - size > size / 2) {
+            spill_free_.emplace(offset + static_cast<int64_t>(size), capacity - size);
+            capacity = size;
+        }
+        return offset;
+    }
+    const int64_t offset = spill_end_;
+    spill_end_ += static_cast<int64_t>(size);
+    capacity = size;
+    return offset;
+}
+
+void TreeManager::releaseSpill(Residency& residency) const
+{
+    if (residency.offset < 0) {
+        return;
+    }
+    int64_t offset = residency.offset;
+    size_t size = residency.capacity;
+    residency.offset = -1;
+    residency.capacity = 0;
+    residency.stored_size = 0;
+    // Слияние с соседними свободными местами
+    auto next = spill_free_.lower_bound(offset);
+    if (next != spill_free_.end() && offset + static_cast<int64_t>(size) == next->first) {
+        size += next->second;
+        next = spill_free_.erase(next);
+    }
+    if (next != spill_free_.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + static_cast<int64_t>(previous->second) == offset) {
+            offset = previous->first;
+            size += previous->second;
+            spill_free_.erase(previous);
+        }
+    }
+    if (offset + static_cast<int64_t>(size) == spill_end_) {
+        spill_end_ = offset;
+    } else {
+        spill_free_.emplace(offset, size);
+    }
+}
+
+void TreeManager::forget(const std::string& name)
+{
+    auto it = residency_.find(name);
+    auto tree = trees_.find(name);
+    if (tree != trees_.end() && tree->second->isSpilled()) {
+        spilled_count_--;
+    }
+    if (it == residency_.end()) {
+        return;
+    }
+    const bool spilled = tree != trees_.end() && tree->second->isSpilled();
+    const size_t bytes = spilled ? it->second.data.size() : it->second.bytes;
+    resident_bytes_ -= std::min(resident_bytes_, bytes);
+    releaseSpill(it->second);
+    residency_.erase(it);
+}
@@ -0,0 +1,89 @@
+#ifndef TREEMANAGER_H
+#define TREEMANAGER_H
+
+#include <string>
+#include <map>
+#include <deque>
+#include <fstream>
+#include <unordered_map>
+#include <cstdint>
+#include "Tree.h"
+
+class TreeManager
+{
+public:
+    TreeManager();
+    ~TreeManager();
+
+    // Добавление/удаление деревьев
+    void addTree(const std::string& name, Tree* tree);
+    void removeTree(const std::string& name);
+    // Вытесненное дерево восстанавливается; nullptr — дерева нет или его не удалось
+    // восстановить (см. hasError)
+    Tree* getTree(const std::string& name) const;
+    bool containsTree(const std::string& name) const;
+
+    // Получение информации
+    int getTreeCount() const { return treeCount_; }
+    // Ссылка действительна до следующего добавления или удаления дерева.
+    // Деревья могут быть вытеснены: содержимое читается только через getTree
+    const std::map<std::string, Tree*>& getAllTrees() const { return trees_; }
+
+    // Очистка менеджера
+    void clear();
+
+    // Бюджет памяти деревьев в байтах (0 — без ограничения). При превышении дольше
+    // всех не менявшиеся деревья вытесняются в компактную форму: в память или,
+    // если задан spill_path, в файл вытеснения. Вытеснение не меняет содержимого
+    // деревьев, поэтому методы, управляющие им, константные
+    void setMemoryBudget(size_t bytes, const std::string& spill_path = std::string());
+    size_t memoryBudget() const { return budget_; }
+    // Пересчитать занятую деревьями память и вытеснить холодные деревья (кроме keep).
+    // Вызывается между строками трассы: проход по всем деревьям
+    void releaseColdTrees(const Tree* keep) const;
+    // Дешевая проверка внутри проходов по деревьям: вытесняются в первую очередь
+    // деревья, восстановленные после последнего releaseColdTrees
+    void trimToBudget(const Tree* keep) const;
+    size_t residentBytes() const { return resident_bytes_; }
+    int spilledCount() const { return spilled_count_; }
+
+    bool hasError() const { return !error_.empty(); }
+    const std::string& errorString() const { return error_; }
+
+private:
+    std::map<std::string, Tree*> trees_;  // Словарь: имя дерева -> указатель на дерево
+    int treeCount_;                       // Счетчик деревьев
+
+    // Учет памяти дерева и его вытесненная форма
+    struct Residency {
+        uint64_t generation = 0;        // Поколение дерева при последнем пересчете
+        uint64_t changed_at = 0;        // Номер пересчета, на котором дерево менялось
+        size_t bytes = 0;               // Оценка памяти дерева при последнем пересчете
+        std::string data;               // Вытесненная форма (без файла вытеснения)
+        int64_t offset = -1;            // Запись в файле вытеснения (-1 — нет)
+        uint64_t stored_generation = 0; // Поколение дерева в записи файла
+        size_t stored_size = 0;
+        size_t capacity = 0;            // Размер места записи в файле (не меньше stored_size)
+    };
+    size_t budget_;
+    std::string spill_path_;
+    mutable std::fstream spill_file_;
+    mutable int64_t spill_end_;
+    // Свободные места файла вытеснения: смещение -> размер. Соседние места сливаются,
+    // место в конце файла возвращается в spill_end_
+    mutable std::map<int64_t, size_t> spill_free_;
+    mutable std::unordered_map<std::string, Residency> residency_;
+    mutable std::deque<std::string> eviction_order_;  // Кандидаты, самые холодные впереди
+    mutable uint64_t scans_;
+    mutable size_t resident_bytes_;
+    mutable int spilled_count_;
+    mutable std::string error_;
+
+    bool spill(Tree* tree, Residency& residency) const;
+    bool restore(const std::string& name, Tree* tree, Residency& residency) const;
+    int64_t allocateSpill(size_t size, size_t& capacity) const;
+    void releaseSpill(Residency& residency) const;
+    void forget(const std::string& name);
+};
+
+#endif // TREEMANAGER_H
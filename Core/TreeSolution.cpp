@@ -0,0 +1,30 @@
+#include "TreeSolution.h"
+#include <algorithm>
+
+TreeSolution::TreeSolution(Verdict verdict)
+    : verdict_(verdict), tree_generation_(0), resolved_(false)
+{
+}
+
+const std::vector<TreeSolution::Assignment>& TreeSolution::assignments(const Tree& tree) const
+{
+    if (resolved_ || model_.empty() || tree.getGeneration() != tree_generation_) {
+        return assignments_;
+    }
+    resolved_ = true;
+    // Переменные формулы в порядке глобальных позиций
+    std::vector<int> order(global_positions_.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = static_cast<int>(i);
+    }
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return global_positions_[a] < global_positions_[b];
+    });
+    for (int index : order) {
+        int position = global_positions_[index];
+        TreeElement element = tree.findElementByPosition(position);
+        assignments_.push_back({position, element ? element.getName() : std::string("Unknown"),
+                             static_cast<bool>(model_[index + 1])});
+    }
+    return assignments_;
+}
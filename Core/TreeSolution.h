@@ -0,0 +1,51 @@
+#ifndef TREESOLUTION_H
+#define TREESOLUTION_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Tree.h"
+
+// Результат решения формулы дерева. Для ответа "есть утечка или нет" достаточно
+// verdict(); модель решателя и имена переменных нужны только отчету и
+// вычисляются при первом вызове assignments().
+class TreeSolution
+{
+public:
+    enum Verdict {
+        NoLeak = 0,
+        Leak,
+        Failed,     // Решатель не дал ответа
+        Unknown     // Решатель остановлен лимитом: ответа нет, анализ продолжается
+    };
+
+    // Значение переменной модели
+    struct Assignment {
+        int position;       // Глобальная позиция переменной
+        std::string name;   // Имя элемента ("Unknown", если элемента с позицией нет)
+        bool value;
+    };
+
+    TreeSolution(Verdict verdict = NoLeak);
+
+    Verdict verdict() const { return verdict_; }
+    bool hasLeak() const { return verdict_ == Leak; }
+    // Модель сохранена (решение запрашивалось с моделью и формула разрешима)
+    bool hasModel() const { return !model_.empty(); }
+
+    // Назначения в порядке глобальных позиций. Имена берутся из индекса позиций
+    // дерева; если дерево изменилось после решения, список пуст.
+    const std::vector<Assignment>& assignments(const Tree& tree) const;
+
+private:
+    friend class TraceAnalyzer;
+
+    Verdict verdict_;
+    uint64_t tree_generation_;              // Поколение дерева на момент решения
+    std::vector<int> global_positions_;     // Переменная формулы - 1 -> глобальная позиция
+    std::vector<bool> model_;               // Значения переменных формулы (с 1)
+    mutable bool resolved_;
+    mutable std::vector<Assignment> assignments_;
+};
+
+#endif // TREESOLUTION_H
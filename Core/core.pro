@@ -0,0 +1,55 @@
+TEMPLATE = lib
+CONFIG += staticlib c++17 thread
+CONFIG -= qt
+
+TARGET = core  # Статическая библиотека ядра, Qt не требуется
+
+INCLUDEPATH += $$PWD/.. /usr/local/include
+
+SOURCES += \
+    BinaryTrace.cpp \
+    BoolVector.cpp \
+    Checkpoint.cpp \
+    Connection.cpp \
+    PositionAllocator.cpp \
+    SolveCache.cpp \
+    SolverStats.cpp \
+    TraceAnalyzer.cpp \
+    TraceRow.cpp \
+    Tree.cpp \
+    TreeElement.cpp \
+    TreeManager.cpp \
+    TreeSolution.cpp \
+    ../CNF/ClauseDatabase.cpp \
+    ../CNF/CnfFormula.cpp \
+    ../CNF/SolverBackend.cpp \
+    ../CNF/MinisatBackend.cpp \
+    ../CNF/DpllBackend.cpp \
+    ../CNF/ExternalBackend.cpp \
+    ../CNF/PortfolioBackend.cpp \
+    ../CNF/SolveWatchdog.cpp
+
+HEADERS += \
+    BinaryTrace.h \
+    BoolVector.h \
+    Checkpoint.h \
+    Connection.h \
+    PositionAllocator.h \
+    SolveCache.h \
+    SolverStats.h \
+    SpscRing.h \
+    TraceAnalyzer.h \
+    TraceRow.h \
+    TraceSource.h \
+    Tree.h \
+    TreeElement.h \
+    TreeManager.h \
+    TreeSolution.h \
+    ../CNF/ClauseDatabase.h \
+    ../CNF/CnfFormula.h \
+    ../CNF/SolverBackend.h \
+    ../CNF/MinisatBackend.h \
+    ../CNF/DpllBackend.h \
+    ../CNF/ExternalBackend.h \
+    ../CNF/PortfolioBackend.h \
+    ../CNF/SolveWatchdog.h
@@ -1,29 +1,8 @@
-QT = core
+TEMPLATE = subdirs
 
-CONFIG += c++17 cmdline
-CONFIG -= app_bundle
-TEMPLATE = app
+# Ядро анализа (без Qt) и приложение с чтением JSON-трасс
+SUBDIRS = core app
 
-TARGET = TreeProgram  # Явно задаем имя программы
-
-INCLUDEPATH += /usr/local/include
-LIBS += -L/usr/local/lib -lminisat
-
-SOURCES += \
-    Connection.cpp \
-    Tree.cpp \
-    TreeElement.cpp \
-    TreeManager.cpp \
-    main.cpp \
-    BoolVector.cpp \
-    Parser_JSON.cpp
-
-HEADERS += \
-    BoolVector.h \
-    Connection.h \
-    Parser_JSON.h \
-    Tree.h \
-    TreeElement.h \
-    TreeManager.h
-
-# УДАЛИТЬ ВСЕ что связано с запуском и копированием!
+core.subdir = Core
+app.file = TreeProgram.pro
+app.depends = core
@@ -0,0 +1,67 @@
+#include "DaemonClient.h"
+#include "LocalSocket.h"
+
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <cstdlib>
+#include <climits>
+
+int DaemonClient::run(const std::string& socket_path, const std::string& trace_path, bool summary_only)
+{
+    const std::string mode = summary_only ? "summary" : "log";
+    std::string request;
+    if (trace_path == "-") {
+        std::string rows((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+        request = "STREAM " + mode + "\nROWS " + std::to_string(rows.size()) + "\n" + rows + "FINISH\n";
+    } else {
+        // Демон работает в своем каталоге, поэтому путь передается абсолютным
+        char resolved[PATH_MAX];
+        if (!realpath(trace_path.c_str(), resolved)) {
+            std::cout << "Error: Failed to open file: " << trace_path << std::endl;
+            return 1;
+        }
+        request = "ANALYZE " + mode + " " + resolved + "\n";
+    }
+
+    LocalSocket socket;
+    std::string error;
+    if (!socket.connectTo(socket_path, error)) {
+        std::cout << "Error: " << error << std::endl;
+        return 1;
+    }
+    if (!socket.writeAll(request)) {
+        std::cout << "Error: Failed to send request to daemon" << std::endl;
+        return 1;
+    }
+    std::string line;
+    while (socket.readLine(line)) {
+        if (line.compare(0, 4, "LOG ") == 0) {
+            std::string text;
+            if (!socket.readExact(std::strtoull(line.c_str() + 4, nullptr, 10), text)) {
+                break;
+            }
+            std::cout << text << std::flush;
+        } else if (line.compare(0, 5, "TREE ") == 0) {
+            if (summary_only) {
+                std::cout << line.substr(5) << std::endl;
+            }
+        } else if (line.compare(0, 7, "RESULT ") == 0) {
+            std::istringstream fields(line.substr(7));
+            std::string result;
+            std::string stop;
+            fields >> result >> stop;
+            if (summary_only) {
+                std::cout << "Result: " << result << (stop.empty() ? "" : " (" + stop + ")") << std::endl;
+            }
+            // Коды выхода однократного запуска: ошибка — 1, остановка на утечке — 2,
+            // лимит времени трассы — 3
+            if (result == "error") {
+                return 1;
+            }
+            return stop == "fail-fast" ? 2 : stop == "time-limit" ? 3 : 0;
+        }
+    }
+    std::cout << "Error: Daemon closed the connection without a result" << std::endl;
+    return 1;
+}
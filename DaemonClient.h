@@ -0,0 +1,15 @@
+#ifndef DAEMONCLIENT_H
+#define DAEMONCLIENT_H
+
+#include <string>
+
+// Клиентский режим: отправить трассу демону (AnalysisDaemon) и вывести ответ.
+// По умолчанию выводится тот же отчет, что и при однократном запуске;
+// trace_path "-" — JSON-трасса читается из stdin и передается потоком.
+class DaemonClient
+{
+public:
+    static int run(const std::string& socket_path, const std::string& trace_path, bool summary_only);
+};
+
+#endif // DAEMONCLIENT_H
@@ -0,0 +1,248 @@
+#include "JsonTraceDecoder.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include "BinaryTrace.h"
+
+bool JsonTraceDecoder::loadRows(const std::string& file_path, QJsonArray& rows, std::string& error)
+{
+    QFile file(QString::fromStdString(file_path));
+    //Проверка открытия файла
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = "Failed to open file: " + file_path;
+        return false;
+    }
+    QJsonParseError parse_error;
+    // Чтение и преобразование прочитанных данных в JSON-документ
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parse_error);
+    file.close();
+    // Проверка документа на пустоту
+    if (doc.isNull()) {
+        error = "JSON parse error: " + parse_error.errorString().toStdString();
+        return false;
+    }
+    return extractRows(doc, rows, error);
+}
+
+bool JsonTraceDecoder::extractRows(const QJsonDocument& doc, QJsonArray& rows, std::string& error)
+{
+    // Проверка, что документ является объектом
+    if (!doc.isObject()) {
+        error = "Invalid JSON structure";
+        return false;
+    }
+    QJsonObject root_obj = doc.object();
+    // Проверка, что документ содержит объект "code"
+    if (!root_obj.contains("code") || !root_obj["code"].isObject()) {
+        error = "Missing 'code' object";
+        return false;
+    }
+    // Проверка, что "code" содержит массив "rows"
+    QJsonObject code_obj = root_obj["code"].toObject();
+    if (!code_obj.contains("rows") || !code_obj["rows"].isArray()) {
+        error = "Missing 'rows' array";
+        return false;
+    }
+    rows = code_obj["rows"].toArray();
+    return true;
+}
+
+bool JsonTraceDecoder::decodeBuffer(const char* data, size_t size,
+                                    std::vector<TraceStatement>& statements, std::string& error)
+{
+    QJsonParseError parse_error;
+    const QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromRawData(data, static_cast<int>(size)),
+                                                      &parse_error);
+    if (doc.isNull()) {
+        error = "JSON parse error: " + parse_error.errorString().toStdString();
+        return false;
+    }
+    // Одна строка, массив строк или целая трасса с code.rows
+    QJsonArray rows;
+    if (doc.isArray()) {
+        rows = doc.array();
+    } else if (doc.isObject() && !doc.object().contains("code")) {
+        rows.append(doc.object());
+    } else if (!extractRows(doc, rows, error)) {
+        return false;
+    }
+    statements.reserve(statements.size() + rows.size());
+    for (const QJsonValue& row : rows) {
+        TraceStatement statement;
+        if (!decodeRow(row, statement, error)) {
+            return false;
+        }
+        statements.push_back(std::move(statement));
+    }
+    return true;
+}
+
+bool JsonTraceDecoder::decodeRow(const QJsonValue& row, TraceStatement& statement, std::string& error)
+{
+    if (!row.isObject()) {
+        error = "Invalid row structure";
+        return false;
+    }
+    QJsonObject row_obj = row.toObject();
+    if (!row_obj.contains("id")) {
+        error = "Row missing id";
+        return false;
+    }
+    statement = decodeStatement(row_obj);
+    statement.id = row_obj["id"].toInt();
+    return true;
+}
+
+bool JsonTraceDecoder::convertToBinary(const std::string& json_path, const std::string& binary_path, std::string& error)
+{
+    QJsonArray rows;
+    if (!loadRows(json_path, rows, error)) {
+        return false;
+    }
+    BinaryTraceWriter writer;
+    for (const QJsonValue& row : rows) {
+        TraceStatement statement;
+        if (!decodeRow(row, statement, error)) {
+            return false;
+        }
+        writer.addRow(statement);
+    }
+    return writer.save(binary_path, error);
+}
+
+TraceStatement JsonTraceDecoder::decodeStatement(const QJsonObject& object)
+{
+    TraceStatement statement;
+    if (object.contains("variable")) {
+        statement.kind = TraceStatement::Variable;
+        statement.variable = object["variable"].toString().toStdString();
+        // "field" учитывается, только если нет "value"
+        if (object.contains("value")) {
+            statement.value = decodeValue(object["value"]);
+        } else if (object.contains("field")) {
+            statement.field = decodeField(object["field"]);
+        }
+    } else if (object.contains("operation")) {
+        statement.kind = TraceStatement::Operation;
+        decodeOperation(object["operation"].toObject(), statement);
+    } else {
+        statement.kind = TraceStatement::Other;
+    }
+    return statement;
+}
+
+void JsonTraceDecoder::decodeOperation(const QJsonObject& op_object, TraceStatement& statement)
+{
+    if (!op_object.contains("op")) {
+        statement.operation = TraceStatement::InvalidOperation;
+        return;
+    }
+    if (op_object["op"].toString() == "loop") {
+        statement.operation = TraceStatement::Loop;
+        statement.loop_valid = op_object.contains("condition") && op_object.contains("body");
+        if (statement.loop_valid) {
+            decodeBody(op_object["body"], statement.body);
+        }
+        return;
+    }
+    // Функции: {"op": "function", "name": ..., "params": [...], "body": [...]}
+    // и вызовы: {"op": "call", "name": ..., "args": [...]}
+    const bool is_function = op_object["op"].toString() == "function";
+    if (is_function || op_object["op"].toString() == "call") {
+        if (!op_object["name"].isString()) {
+            statement.operation = TraceStatement::InvalidOperation;
+            return;
+        }
+        statement.operation = is_function ? TraceStatement::Function : TraceStatement::Call;
+        statement.function = op_object["name"].toString().toStdString();
+        for (const QJsonValue& name : op_object[is_function ? "params" : "args"].toArray()) {
+            statement.arguments.push_back(name.toString().toStdString());
+        }
+        if (is_function) {
+            decodeBody(op_object["body"], statement.body);
+        }
+        return;
+    }
+    statement.operation = TraceStatement::Branch;
+    // Ветка учитывается, только если это объект с "body"
+    QJsonValue branch_true = op_object["branch true"];
+    if (branch_true.isObject() && branch_true.toObject().contains("body")) {
+        statement.has_branch_true = true;
+        decodeBody(branch_true.toObject()["body"], statement.branch_true);
+    }
+    QJsonValue branch_false = op_object["branch false"];
+    if (branch_false.isObject() && branch_false.toObject().contains("body")) {
+        statement.has_branch_false = true;
+        decodeBody(branch_false.toObject()["body"], statement.branch_false);
+    }
+}
+
+void JsonTraceDecoder::decodeBody(const QJsonValue& body_value, std::vector<TraceStatement>& body)
+{
+    // Вложенные массивы разворачиваются в один список
+    if (body_value.isObject()) {
+        body.push_back(decodeStatement(body_value.toObject()));
+    } else if (body_value.isArray()) {
+        QJsonArray body_array = body_value.toArray();
+        for (const QJsonValue& item : body_array) {
+            decodeBody(item, body);
+        }
+    }
+}
+
+TraceValue JsonTraceDecoder::decodeValue(const QJsonValue& value)
+{
+    TraceValue result;
+    if (value.isNull()) {
+        result.kind = TraceValue::Null;
+    } else if (value.isString()) {
+        result.kind = TraceValue::Operation;
+        result.text = value.toString().toStdString();
+        result.op = traceOpFromString(result.text);
+    } else if (value.isObject()) {
+        QJsonObject value_obj = value.toObject();
+        if (!value_obj.contains("variable")) {
+            result.kind = TraceValue::InvalidNested;
+            return result;
+        }
+        result.kind = TraceValue::Nested;
+        result.text = value_obj["variable"].toString().toStdString();
+        if (value_obj.contains("field")) {
+            QJsonValue field_value = value_obj["field"];
+            if (!field_value.isObject()) {
+                result.field_kind = TraceValue::InvalidField;
+            } else if (field_value.toObject()["f"].isString()) {
+                result.field_kind = TraceValue::DirectedField;
+                result.field_direction = field_value.toObject()["f"].toString().toStdString();
+                result.field_dir = fieldDirectionFromString(result.field_direction);
+            } else {
+                result.field_kind = TraceValue::PlainField;
+            }
+        }
+    } else {
+        result.kind = TraceValue::Other;
+    }
+    return result;
+}
+
+std::shared_ptr<TraceField> JsonTraceDecoder::decodeField(const QJsonValue& field_value)
+{
+    std::shared_ptr<TraceField> field = std::make_shared<TraceField>();
+    field->valid = field_value.isObject();
+    if (!field->valid) {
+        return field;
+    }
+    QJsonObject field_obj = field_value.toObject();
+    if (field_obj.contains("f") && field_obj["f"].isString()) {
+        field->has_direction = true;
+        field->direction = field_obj["f"].toString().toStdString();
+        field->dir = fieldDirectionFromString(field->direction);
+    }
+    if (field_obj.contains("op")) {
+        field->op = decodeField(field_obj["op"]);
+    }
+    if (field_obj.contains("value")) {
+        field->value = decodeValue(field_obj["value"]);
+    }
+    return field;
+}
@@ -0,0 +1,36 @@
+#ifndef JSONTRACEDECODER_H
+#define JSONTRACEDECODER_H
+
+#include <string>
+#include <memory>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+
+#include "TraceRow.h"
+
+// Декодирование JSON-трассы (code.rows) в типизированные строки ядра
+class JsonTraceDecoder
+{
+public:
+    // Загрузить файл и извлечь массив code.rows
+    static bool loadRows(const std::string& file_path, QJsonArray& rows, std::string& error);
+    // Декодировать строки из буфера в памяти: одну строку, массив строк или трассу целиком
+    static bool decodeBuffer(const char* data, size_t size,
+                             std::vector<TraceStatement>& statements, std::string& error);
+    // Декодировать одну строку верхнего уровня
+    static bool decodeRow(const QJsonValue& row, TraceStatement& statement, std::string& error);
+    // Однократная конвертация JSON-трассы в бинарный формат
+    static bool convertToBinary(const std::string& json_path, const std::string& binary_path, std::string& error);
+
+private:
+    static bool extractRows(const QJsonDocument& doc, QJsonArray& rows, std::string& error);
+    static TraceStatement decodeStatement(const QJsonObject& object);
+    static void decodeOperation(const QJsonObject& op_object, TraceStatement& statement);
+    static void decodeBody(const QJsonValue& body_value, std::vector<TraceStatement>& body);
+    static TraceValue decodeValue(const QJsonValue& value);
+    static std::shared_ptr<TraceField> decodeField(const QJsonValue& field_value);
+};
+
+#endif // JSONTRACEDECODER_H
@@ -0,0 +1,33 @@
+#include "JsonTraceSource.h"
+#include "JsonTraceDecoder.h"
+
+JsonTraceSource::JsonTraceSource()
+    : index_(0)
+{
+}
+
+bool JsonTraceSource::open(const std::string& file_path)
+{
+    index_ = 0;
+    error_.clear();
+    return JsonTraceDecoder::loadRows(file_path, rows_, error_);
+}
+
+bool JsonTraceSource::next(TraceStatement& row)
+{
+    if (index_ >= rows_.size()) {
+        return false;
+    }
+    return JsonTraceDecoder::decodeRow(rows_.at(index_++), row, error_);
+}
+
+bool JsonTraceSource::skip(int64_t rows)
+{
+    int64_t remaining = rows_.size() - index_;
+    if (rows > remaining) {
+        index_ = rows_.size();
+        return false;
+    }
+    index_ += static_cast<int>(rows);
+    return true;
+}
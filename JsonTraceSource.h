@@ -0,0 +1,27 @@
+#ifndef JSONTRACESOURCE_H
+#define JSONTRACESOURCE_H
+
+#include <string>
+#include <QJsonArray>
+
+#include "TraceSource.h"
+
+// Источник строк ядра поверх JSON-трассы (массив code.rows)
+class JsonTraceSource : public TraceSource
+{
+public:
+    JsonTraceSource();
+
+    bool open(const std::string& file_path);
+
+    int64_t rowCount() const override { return rows_.size(); }
+    bool next(TraceStatement& row) override;
+    // Пропуск без декодирования: строки массива доступны по индексу
+    bool skip(int64_t rows) override;
+
+private:
+    QJsonArray rows_;
+    int index_;
+};
+
+#endif // JSONTRACESOURCE_H
@@ -0,0 +1,104 @@
+#include "LocalSocket.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Ограничение длины командной строки протокола
+static const size_t kMaxLineLength = 64 * 1024;
+
+LocalSocket::LocalSocket(int fd)
+    : fd_(fd)
+{
+}
+
+LocalSocket::~LocalSocket()
+{
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+bool LocalSocket::connectTo(const std::string& path, std::string& error)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        error = "Socket path is too long: " + path;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+    fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd_ < 0) {
+        error = std::string("Failed to create socket: ") + std::strerror(errno);
+        return false;
+    }
+    if (::connect(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        error = "Failed to connect to " + path + ": " + std::strerror(errno);
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    return true;
+}
+
+bool LocalSocket::fill()
+{
+    char chunk[65536];
+    for (;;) {
+        ssize_t received = ::recv(fd_, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            buffer_.append(chunk, static_cast<size_t>(received));
+            return true;
+        }
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        return false;
+    }
+}
+
+bool LocalSocket::readLine(std::string& line)
+{
+    size_t end;
+    while ((end = buffer_.find('\n')) == std::string::npos) {
+        if (buffer_.size() > kMaxLineLength || !fill()) {
+            return false;
+        }
+    }
+    line.assign(buffer_, 0, end);
+    buffer_.erase(0, end + 1);
+    return true;
+}
+
+bool LocalSocket::readExact(size_t size, std::string& data)
+{
+    while (buffer_.size() < size) {
+        if (!fill()) {
+            return false;
+        }
+    }
+    data.assign(buffer_, 0, size);
+    buffer_.erase(0, size);
+    return true;
+}
+
+bool LocalSocket::writeAll(const std::string& data)
+{
+    size_t sent = 0;
+    while (sent < data.size()) {
+        // MSG_NOSIGNAL: закрытый собеседник не должен завершать процесс сигналом SIGPIPE
+        ssize_t written = ::send(fd_, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    return true;
+}
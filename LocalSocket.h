@@ -0,0 +1,32 @@
+#ifndef LOCALSOCKET_H
+#define LOCALSOCKET_H
+
+#include <string>
+
+// Соединение через Unix-сокет (POSIX) с построчным и блочным чтением.
+// Используется демоном и клиентом; дескриптор закрывается в деструкторе.
+class LocalSocket
+{
+public:
+    explicit LocalSocket(int fd = -1);
+    ~LocalSocket();
+    LocalSocket(const LocalSocket&) = delete;
+    LocalSocket& operator=(const LocalSocket&) = delete;
+
+    bool connectTo(const std::string& path, std::string& error);
+    bool isOpen() const { return fd_ >= 0; }
+
+    // Строка без завершающего '\n'; false — соединение закрыто или слишком длинная строка
+    bool readLine(std::string& line);
+    // Ровно size байт
+    bool readExact(size_t size, std::string& data);
+    bool writeAll(const std::string& data);
+
+private:
+    int fd_;
+    std::string buffer_;    // Прочитанные, но еще не отданные байты
+
+    bool fill();
+};
+
+#endif // LOCALSOCKET_H
@@ -0,0 +1,33 @@
+QT = core
+
+CONFIG += c++17 cmdline thread
+CONFIG -= app_bundle
+TEMPLATE = app
+
+TARGET = TreeProgram  # Явно задаем имя программы
+
+# Ядро анализа собирается отдельной статической библиотекой (Core/core.pro)
+INCLUDEPATH += $$PWD/Core $$PWD /usr/local/include
+LIBS += -L$$OUT_PWD/Core -lcore -L/usr/local/lib -lminisat
+PRE_TARGETDEPS += $$OUT_PWD/Core/libcore.a
+
+SOURCES += \
+    main.cpp \
+    Parser_JSON.cpp \
+    JsonTraceDecoder.cpp \
+    JsonTraceSource.cpp \
+    AnalysisOptions.cpp \
+    AnalysisDaemon.cpp \
+    DaemonClient.cpp \
+    LocalSocket.cpp
+
+HEADERS += \
+    AnalysisDaemon.h \
+    AnalysisOptions.h \
+    DaemonClient.h \
+    JsonTraceDecoder.h \
+    JsonTraceSource.h \
+    LocalSocket.h \
+    Parser_JSON.h
+
+# УДАЛИТЬ ВСЕ что связано с запуском и копированием!
@@ -1,36 +1,237 @@
-#include <QCoreApplication>
 #include <iostream>
+#include <string>
+#include <cstdlib>
+#include <csignal>
+#include <sstream>
+#include <thread>
 #include "Parser_JSON.h"
+#include "JsonTraceDecoder.h"
+#include "AnalysisOptions.h"
+#include "AnalysisDaemon.h"
+#include "DaemonClient.h"
+
+// Анализатор, которому SIGUSR1 заказывает полный вывод деревьев
+static Parser_JSON* dump_target = nullptr;
+
+static void requestFullDump(int)
+{
+    if (dump_target) {
+        dump_target->requestFullDump();
+    }
+}
+
+// Демон, которому SIGINT/SIGTERM заказывают остановку
+static AnalysisDaemon* stop_target = nullptr;
+
+static void requestStop(int)
+{
+    if (stop_target) {
+        stop_target->stop();
+    }
+}
+
+// Целое число аргумента целиком, без хвоста
+static bool parseInt(const std::string& text, int& value)
+{
+    char* end = nullptr;
+    long parsed = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0') {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
 
 int main(int argc, char *argv[])
 {
-    QCoreApplication app(argc, argv);
+    // Однократное преобразование JSON-трассы в бинарный формат
+    if (argc >= 2 && std::string(argv[1]) == "--convert") {
+        if (argc != 4) {
+            std::cout << "Usage: " << argv[0] << " --convert <json_file_path> <binary_file_path>" << std::endl;
+            return 1;
+        }
+        std::string error;
+        if (!JsonTraceDecoder::convertToBinary(argv[2], argv[3], error)) {
+            std::cout << "Error: " << error << std::endl;
+            return 1;
+        }
+        std::cout << "Trace converted: " << argv[3] << std::endl;
+        return 0;
+    }
 
-    if (argc != 2) {
-        std::cout << "Usage: " << argv[0] << " <json_file_path>" << std::endl;
+    std::string file_path;
+    AnalysisOptions options;
+    std::string checkpoint_path;
+    std::string resume_path;
+    int checkpoint_interval = 5;
+    std::string stats_json_path;
+    std::string stats_prometheus_path;
+    std::string daemon_socket;
+    std::string connect_socket;
+    bool summary_only = false;
+    int workers = static_cast<int>(std::thread::hardware_concurrency());
+    bool args_ok = true;
+    for (int i = 1; i < argc && args_ok; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--compact-positions") {
+            options.compact_positions = true;
+        } else if (arg == "--no-pipeline") {
+            options.pipeline = false;
+        } else if (arg == "--report" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            args_ok = mode == "full" || mode == "delta";
+            options.report_mode = mode == "delta" ? TraceAnalyzer::DeltaReport : TraceAnalyzer::FullReport;
+        } else if (arg == "--fail-fast") {
+            options.fail_fast = true;
+        } else if (arg == "--show-model") {
+            options.show_model = true;
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            checkpoint_path = argv[++i];
+        } else if (arg == "--checkpoint-interval" && i + 1 < argc) {
+            args_ok = parseInt(argv[++i], checkpoint_interval);
+            args_ok = args_ok && checkpoint_interval >= 0;
+        } else if (arg == "--resume" && i + 1 < argc) {
+            resume_path = argv[++i];
+        } else if (arg == "--solver" && i + 1 < argc) {
+            options.solver_spec = argv[++i];
+        } else if (arg == "--portfolio" && i + 1 < argc) {
+            options.portfolio_members = argv[++i];
+        } else if (arg == "--portfolio-threshold" && i + 1 < argc) {
+            args_ok = parseInt(argv[++i], options.portfolio_threshold);
+            args_ok = args_ok && options.portfolio_threshold >= 0;
+        } else if (arg == "--summarize-sites" && i + 1 < argc) {
+            args_ok = parseInt(argv[++i], options.site_summary_limit);
+            args_ok = args_ok && options.site_summary_limit >= 0;
+        } else if (arg == "--solve-conflicts" && i + 1 < argc) {
+            args_ok = parseInt(argv[++i], options.solve_conflicts);
+            args_ok = args_ok && options.solve_conflicts >= 0;
+        } else if (arg == "--solve-propagations" && i + 1 < argc) {
+            args_ok = parseInt(argv[++i], options.solve_propagations);
+            args_ok = args_ok && options.solve_propagations >= 0;
+        } else if (arg == "--solve-timeout" && i + 1 < argc) {
+            args_ok = parseInt(argv[++i], options.solve_timeout_ms);
+            args_ok = args_ok && options.solve_timeout_ms >= 0;
+        } else if (arg == "--trace-time-limit" && i + 1 < argc) {
+            args_ok = parseInt(argv[++i], options.trace_time_limit);
+            args_ok = args_ok && options.trace_time_limit >= 0;
+        } else if (arg == "--memory-budget" && i + 1 < argc) {
+            args_ok = parseInt(argv[++i], options.memory_budget_mb);
+            args_ok = args_ok && options.memory_budget_mb >= 0;
+        } else if (arg == "--spill-file" && i + 1 < argc) {
+            options.spill_file = argv[++i];
+        } else if (arg == "--stats-json" && i + 1 < argc) {
+            stats_json_path = argv[++i];
+        } else if (arg == "--stats-prometheus" && i + 1 < argc) {
+            stats_prometheus_path = argv[++i];
+        } else if (arg == "--dump-dimacs" && i + 1 < argc) {
+            options.dimacs_dir = argv[++i];
+        } else if (arg == "--daemon" && i + 1 < argc) {
+            daemon_socket = argv[++i];
+        } else if (arg == "--workers" && i + 1 < argc) {
+            args_ok = parseInt(argv[++i], workers);
+            args_ok = args_ok && workers > 0;
+        } else if (arg == "--connect" && i + 1 < argc) {
+            connect_socket = argv[++i];
+        } else if (arg == "--summary") {
+            summary_only = true;
+        } else if (arg.compare(0, 2, "--") != 0 && file_path.empty()) {
+            file_path = arg;
+        } else {
+            args_ok = false;
+        }
+    }
+    // Демон не принимает трассу в командной строке, остальные режимы требуют ее
+    args_ok = args_ok && (daemon_socket.empty() ? !file_path.empty() : file_path.empty());
+    args_ok = args_ok && (daemon_socket.empty() || connect_socket.empty());
+    // Файл вытеснения принадлежит одному анализатору, а демон ведет их несколько
+    args_ok = args_ok && (daemon_socket.empty() || options.spill_file.empty());
+    // Номера файлов формул свои у каждого анализатора: одновременные запросы перезаписали бы их
+    args_ok = args_ok && (daemon_socket.empty() || options.dimacs_dir.empty());
+    // Статистика решателя выгружается по итогам одного прогона
+    args_ok = args_ok && (daemon_socket.empty() || (stats_json_path.empty() && stats_prometheus_path.empty()));
+
+    if (!args_ok) {
+        std::cout << "Usage: " << argv[0] << " [--compact-positions] [--no-pipeline] [--checkpoint <path>] [--checkpoint-interval <sec>]"
+                  << " [--resume <path>] [--solver <spec>] [--portfolio <spec,...|default>]"
+                  << " [--portfolio-threshold <connections>] [--dump-dimacs <dir>] [--show-model]"
+                  << " [--report full|delta] [--summarize-sites <nodes>] [--fail-fast]"
+                  << " [--solve-conflicts <N>] [--solve-propagations <N>] [--solve-timeout <ms>]"
+                  << " [--trace-time-limit <sec>] [--memory-budget <MB>] [--spill-file <path>]"
+                  << " [--stats-json <path>] [--stats-prometheus <path>]"
+                  << " <trace_file_path>" << std::endl;
+        std::cout << "       " << argv[0] << " --daemon <socket_path> [--workers <count>] [analysis options]" << std::endl;
+        std::cout << "       " << argv[0] << " --connect <socket_path> [--summary] <trace_file_path|->" << std::endl;
+        std::cout << "       " << argv[0] << " --convert <json_file_path> <binary_file_path>" << std::endl;
         return 1;
     }
 
-    QString file_path = QString::fromUtf8(argv[1]);
+    // Клиент: анализ выполняет демон с его настройками
+    if (!connect_socket.empty()) {
+        return DaemonClient::run(connect_socket, file_path, summary_only);
+    }
+
+    if (!daemon_socket.empty()) {
+        // Настройки проверяются один раз при запуске, а не в каждом запросе
+        std::ostringstream check_output;
+        Parser_JSON check_parser;
+        check_parser.setOutput(check_output);
+        if (!options.configure(check_parser)) {
+            std::cout << check_output.str();
+            return 1;
+        }
+        AnalysisDaemon daemon(options, workers);
+        if (!daemon.listen(daemon_socket)) {
+            std::cout << "Error: " << daemon.errorString() << std::endl;
+            return 1;
+        }
+        // SIGINT/SIGTERM: прекратить прием и дождаться начатых запросов
+        stop_target = &daemon;
+        std::signal(SIGINT, requestStop);
+        std::signal(SIGTERM, requestStop);
+        int code = daemon.run();
+        stop_target = nullptr;
+        return code;
+    }
 
     Parser_JSON parser;
-    bool success = parser.parseJsonFile(file_path);
+    if (!options.configure(parser)) {
+        return 1;
+    }
+    // kill -USR1 <pid>: полный вывод всех деревьев после текущей строки
+    dump_target = &parser;
+    std::signal(SIGUSR1, requestFullDump);
+    // При возобновлении контрольные точки по умолчанию пишутся туда же
+    if (checkpoint_path.empty()) {
+        checkpoint_path = resume_path;
+    }
+    bool success = resume_path.empty() || parser.resumeFrom(resume_path);
+    if (success && !checkpoint_path.empty()) {
+        parser.enableCheckpoints(checkpoint_path, checkpoint_interval);
+    }
+    success = success && parser.parseFile(file_path);
+    std::signal(SIGUSR1, SIG_IGN);
+    dump_target = nullptr;
 
-    if (success) {
-        std::cout << "\n=== Parsing completed successfully ===" << std::endl;
-        parser.printElements();
+    parser.printRunSummary(success);
 
-        if (parser.hasMemoryLeak()) {
-            std::cout << "WARNING: Memory leaks detected!" << std::endl;
-        } else {
-            std::cout << "No memory leaks detected." << std::endl;
-        }
-    } else {
-        std::cout << "\n=== Parsing failed ===" << std::endl;
-        if (parser.hasError()) {
-            std::cout << "Errors occurred during parsing." << std::endl;
+    // Статистика решателя пишется и после ошибки или досрочной остановки
+    const std::pair<std::string, SolverStats::Format> stats_files[] = {
+        {stats_json_path, SolverStats::Json}, {stats_prometheus_path, SolverStats::Prometheus}};
+    for (const auto& stats_file : stats_files) {
+        std::string error;
+        if (!stats_file.first.empty() && !parser.solverStats().writeFile(stats_file.first, stats_file.second, error)) {
+            std::cout << "Error: " << error << std::endl;
+            return 1;
         }
     }
 
-    return 0;
+    // Отдельные коды выхода для остановки на утечке и по лимиту времени трассы,
+    // чтобы CI отличал их от ошибки
+    if (!success) {
+        return 1;
+    }
+    if (parser.stoppedOnLeak()) {
+        return 2;
+    }
+    return parser.timeLimitExceeded() ? 3 : 0;
 }